@@ -0,0 +1,86 @@
+#ifndef MDR_ADAPTIVE_FRONT_H
+#define MDR_ADAPTIVE_FRONT_H
+
+#include <vector>
+
+#include "../headers/DesignClasses.h"
+
+namespace MDR {
+
+	// The code in this file is of my own design.
+	//
+	// Every engine below finds the same front: the designs dominated the minimum number of
+	// times according to MDR (as find_pareto_front for a single dominance relation). Which
+	// one is fastest depends on the population. find_pareto_front_adaptive samples the
+	// designs to estimate the fraction of them in the front, the correlation between the
+	// metrics of the first dominance relation and the fraction of duplicate designs, and
+	// picks an engine from those estimates, the number of designs and the number of layers:
+	//
+	//  - small lists: the pairwise loop, which has no setup cost
+	//  - a single dominance relation: the radix sort sweep, split across threads for very
+	//    large lists. It is O(n log n) whatever the shape of the population.
+	//  - several layers, correlated metrics and a small front: the early exit peel of
+	//    FrontGenerator, in which most designs are found to be dominated after a few checks
+	//  - several layers and few distinct designs: the pairwise loop on collapsed duplicates
+	//  - several layers otherwise: the bitset engine
+	//
+	// The thresholds were measured on random populations and are only a guide. Once a
+	// workload has been profiled, the engine can be pinned through FrontEngineOptions::engine.
+
+	enum class FrontEngine {
+		Auto,			// Choose from the shape of the population
+		Pairwise,		// count_dominations
+		EarlyExit,		// First front of FrontGenerator
+		Sweep,			// find_pareto_front_radix on one thread (single dominance relation only)
+		ThreadedSweep,	// find_pareto_front_radix on num_threads threads (idem)
+		Bitset			// bitset_count_dominations on a Population
+	};
+
+	struct FrontEngineOptions {
+		FrontEngine engine = FrontEngine::Auto;
+		size_t sample_size = 128; // Number of designs sampled to estimate the population shape
+		size_t num_threads = 0; // Threads of ThreadedSweep (0 for every hardware thread)
+		bool collapse_duplicates = false; // Collapse duplicate designs when Pairwise is used
+		bool verbose = false; // Report the choice and its timing to std::cout
+	};
+
+	// What find_pareto_front_adaptive found and chose
+	struct FrontEngineReport {
+		FrontEngine engine = FrontEngine::Auto;
+		bool collapse_duplicates = false;
+		size_t num_sampled = 0;
+		double front_fraction = 0; // Fraction of the sample in the front of the sample
+		size_t min_dominations = 0; // Above 0 if the sample holds a cycle
+		double correlation = 0; // Correlation of the corrected metrics of the first layer
+		double duplicate_fraction = 0; // Fraction of the sample equal to another sampled design
+		double seconds = 0; // Time taken by the engine
+	};
+
+	// Return the name of an engine
+	const char* get_front_engine_name(const FrontEngine& engine);
+
+	// Estimate the shape of a list of designs from an evenly spread sample and choose an
+	// engine. A sweep engine pinned in options is ignored (and an engine chosen instead) if
+	// there are several dominance relations. Please note that the output (report) is an
+	// argument of this function.
+	FrontEngine choose_front_engine(const std::vector<Design>& design_list,
+		const std::vector<DomRel>& dom_rels, const FrontEngineOptions& options,
+		FrontEngineReport& report);
+
+	// Returns the designs of a list dominated the minimum number of times according to MDR,
+	// in their original order, using the engine chosen by options. Please note that the
+	// report is an argument of this function.
+	std::vector<Design> find_pareto_front_adaptive(const std::vector<Design>& design_list,
+		const std::vector<DomRel>& dom_rels, const FrontEngineOptions& options,
+		FrontEngineReport& report);
+
+	std::vector<Design> find_pareto_front_adaptive(const std::vector<Design>& design_list,
+		const std::vector<DomRel>& dom_rels, const FrontEngineOptions& options = {});
+
+	// Returns the 2D pareto front within a list of designs and a dominance relation, as
+	// find_pareto_front
+	std::vector<Design> find_pareto_front_adaptive(const std::vector<Design>& design_list,
+		const DomRel& dom_rel, const FrontEngineOptions& options = {});
+}
+
+#endif
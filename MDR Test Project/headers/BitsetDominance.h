@@ -0,0 +1,60 @@
+#ifndef MDR_BITSET_DOMINANCE_H
+#define MDR_BITSET_DOMINANCE_H
+
+#include <vector>
+#include <cstdint>
+
+#include "../headers/DesignClasses.h"
+#include "../headers/Population.h"
+
+namespace MDR {
+
+	// The code in this file is of my own design.
+	//
+	// Bit-parallel dominance engine for mid-size populations. Every metric column is sorted
+	// once; the designs strictly better than a design B in a metric are then a prefix of that
+	// order and can be turned into a bitset over the population. The designs dominating B in
+	// a dominance relation are the AND of two such bitsets, and the designs dominating B
+	// according to MDR are combined layer by layer:
+	//
+	//   dominators = dominators | (undecided & better_in_layer)
+	//   undecided  = undecided & ~better_in_layer & ~worse_in_layer
+	//
+	// The number of times B is dominated is then a popcount. The loops run over 64 bit words,
+	// which the compiler can vectorise: the project builds for SSE2 on x64, so an instruction
+	// then handles 128 designs.
+	//
+	// The bitsets are built for blocks of designs at a time, so that at most memory_budget
+	// bytes are used whatever the size of the population.
+
+	// Dominance relation evaluated by the engine
+	enum class BitsetRelation {
+		MDR,	// As A_dominates_B_MDR: the first decisive layer wins
+		MO		// As A_dominates_B_MO: A must dominate B in every layer
+	};
+
+	// Default memory budget of the engine (in bytes)
+	const size_t BITSET_DEFAULT_MEMORY = size_t(256) << 20;
+
+	// Count the number of designs dominating each design of a population given a list of
+	// dominance relations. The result is the same as that of count_dominations. Please note
+	// that the output (dominations) is an argument of this function.
+	template <typename T>
+	void bitset_count_dominations(const Population<T>& population,
+		const std::vector<DomRel>& dom_rels, std::vector<size_t>& dominations,
+		const BitsetRelation& relation = BitsetRelation::MDR,
+		const size_t& memory_budget = BITSET_DEFAULT_MEMORY);
+
+	// Sort a population into successive fronts: front 0 holds the designs which are not
+	// dominated, front 1 those only dominated by designs of front 0, and so on. If every
+	// remaining design is dominated (MDR can hold cycles), the designs dominated the minimum
+	// number of times make up the next front, as in find_pareto_front. Please note that the
+	// output (front_ids, one per design) is an argument of this function.
+	template <typename T>
+	void bitset_front_indices(const Population<T>& population,
+		const std::vector<DomRel>& dom_rels, std::vector<size_t>& front_ids,
+		const BitsetRelation& relation = BitsetRelation::MDR,
+		const size_t& memory_budget = BITSET_DEFAULT_MEMORY);
+}
+
+#endif
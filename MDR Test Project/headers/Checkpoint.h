@@ -0,0 +1,171 @@
+#ifndef MDR_CHECKPOINT_H
+#define MDR_CHECKPOINT_H
+
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include <cstdint>
+
+#include "../headers/DesignClasses.h"
+
+namespace MDR {
+
+	// The code in this file is of my own design.
+	//
+	// A checkpoint stores the full ranking state of an optimization run: the performance
+	// metrics of every design (column by column), the per-layer rank matrix, the front
+	// membership of every design and the order of the dominance relations.
+	//
+	// The file is append-only. Every call to CheckpointWriter::append writes the designs
+	// which were added since the previous call (a "rows" record) followed by the ranks and
+	// fronts which have changed (a "delta" record, linked to the previous one), and only then
+	// points the file header at the new delta. A run which is interrupted half way through an
+	// append therefore restores the previous state. The full ranks and fronts (a "state"
+	// record) are only written when the file is compacted, which append does once the latest
+	// state is followed by too many deltas.
+	//
+	// Rows are never rewritten by an append, so the metric values of a design must not change
+	// once it has been appended, unless CheckpointWriter::mark_changed is called: the next
+	// append then compacts the file, which writes every row again.
+	//
+	// All records are made of 64 bit words in the native byte order, so a checkpoint can be
+	// memory mapped and read in place by CheckpointReader: opening it only parses the
+	// header, the state, the list of rows records and the entries of the deltas, whatever the
+	// number of designs.
+
+	// Given the output of optimize_designs, find for every design of design_list the index
+	// of the deepest front which contains it (designs are matched by their design id).
+	// Please note that the output (front_ids) is an argument of this function.
+	void find_front_ids(const std::vector<Design>& design_list,
+		const std::vector<std::vector<Design>>& fronts, std::vector<size_t>& front_ids);
+
+	class CheckpointWriter {
+		std::string m_filename;
+		uint64_t m_file_size = 0;
+		uint64_t m_head_offset = 0; // Offset of the latest state or delta
+		uint64_t m_num_deltas = 0; // Number of deltas after the latest state
+		uint64_t m_rows_written = 0;
+		bool m_rows_changed = false; // Whether the values of a written row have changed
+		std::vector<uint64_t> m_dom_rels; // Written dominance relations, two words each
+		std::vector<uint64_t> m_ranks; // Written ranks, num_layers per design
+		std::vector<uint64_t> m_front_ids; // Written front ids
+
+	public:
+		// Default constructor (constructs an empty object)
+		CheckpointWriter() {}
+
+		// Open a checkpoint file for writing. An existing checkpoint is resumed: only the
+		// designs after the ones it already holds are appended by the next call to append.
+		// This function will return true if the operation is successful.
+		bool open(const std::string& filename);
+
+		// Append the current ranking state. The designs must be the ones of the previous
+		// call to append, followed by any new design. Their ranks may have changed, but not
+		// their metric values (see mark_changed). The ranks are read from the designs and
+		// front_ids must hold one entry per design. This function will return true if the
+		// operation is successful.
+		bool append(const std::vector<Design>& design_list, const std::vector<DomRel>& dom_rels,
+			const std::vector<size_t>& front_ids);
+
+		// Record that the metric values of the design at idx have changed (e.g. through
+		// Design::set_perf_val or IncrementalRanking::set_perf_val). If it has already been
+		// written, the next call to append rewrites every row.
+		void mark_changed(const size_t& idx);
+
+		// Rewrite the checkpoint so it only holds a single rows record and the current state.
+		// This is done automatically by append once the latest state is followed by too many
+		// deltas, or when a delta cannot describe the changes.
+		bool compact(const std::vector<Design>& design_list, const std::vector<DomRel>& dom_rels,
+			const std::vector<size_t>& front_ids);
+
+		// Size of the checkpoint file in bytes
+		uint64_t get_file_size() const { return m_file_size; }
+	};
+
+	class CheckpointReader {
+		// A rows record as found in the mapped file
+		struct RowSegment {
+			uint64_t row_begin = 0;
+			uint64_t row_count = 0;
+			const uint64_t* design_ids = nullptr;
+			const double* values = nullptr; // num_metrics columns of row_count values
+		};
+
+		const unsigned char* m_data = nullptr;
+		uint64_t m_size = 0;
+		uint64_t m_head_offset = 0;
+		uint64_t m_num_deltas = 0;
+		void* m_handle = nullptr; // Platform specific mapping handle
+
+		uint64_t m_num_designs = 0;
+		uint64_t m_num_metrics = 0;
+		uint64_t m_num_layers = 0;
+		const uint64_t* m_metric_ids = nullptr;
+		const uint64_t* m_minimize = nullptr;
+		const uint64_t* m_dom_rels = nullptr;
+		const uint64_t* m_ranks = nullptr;
+		const uint64_t* m_front_ids = nullptr;
+		std::vector<std::string> m_metric_names;
+		std::vector<RowSegment> m_segments;
+		// Ranks then front id of every design found in a delta, by design index
+		std::unordered_map<uint64_t, const uint64_t*> m_changed;
+
+	public:
+		// Default constructor (constructs an empty object)
+		CheckpointReader() {}
+
+		~CheckpointReader() { close(); }
+
+		CheckpointReader(const CheckpointReader&) = delete;
+		CheckpointReader& operator=(const CheckpointReader&) = delete;
+
+		// Memory map a checkpoint file. This function will return true if the file holds a
+		// valid checkpoint.
+		bool open(const std::string& filename);
+
+		// Unmap the checkpoint file
+		void close();
+
+		size_t size() const { return m_num_designs; }
+
+		size_t get_num_metrics() const { return m_num_metrics; }
+
+		size_t get_num_layers() const { return m_num_layers; }
+
+		// Size of the mapped file
+		uint64_t get_file_size() const { return m_size; }
+
+		// Offset of the latest state or delta and number of deltas after the latest state
+		// (used to resume writing)
+		uint64_t get_head_offset() const { return m_head_offset; }
+		uint64_t get_num_deltas() const { return m_num_deltas; }
+
+		MetricID get_metric_id(const size_t& col) const;
+
+		bool get_minimize(const size_t& col) const { return m_minimize[col] != 0; }
+
+		// Get the dominance relations in the order they were used
+		std::vector<DomRel> get_dom_rels() const;
+
+		size_t get_design_id(const size_t& idx) const;
+
+		// Value of the performance metric stored in column col for the design at idx
+		double get_val(const size_t& idx, const size_t& col) const;
+
+		// Rank of the design at idx in a dominance layer
+		size_t get_rank(const size_t& idx, const size_t& layer) const;
+
+		// Index of the deepest front which contains the design at idx
+		size_t get_front_id(const size_t& idx) const;
+
+		// Rebuild the list of designs (with their ranks) from the checkpoint. Unlike the
+		// accessors above, this takes a time proportional to the number of designs.
+		void restore_designs(std::vector<Design>& design_list) const;
+
+	private:
+		// Find the rows record holding a design
+		const RowSegment& find_segment(const size_t& idx) const;
+	};
+}
+
+#endif
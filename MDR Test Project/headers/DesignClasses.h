@@ -4,7 +4,10 @@
 #include <iostream>
 #include <vector>
 #include <string>
+#include <string_view>
+#include <span>
 #include <array>
+#include <type_traits>
 
 namespace MDR {
 
@@ -33,6 +36,9 @@ namespace MDR {
 
 		std::string get_name() const;
 
+		// View of the name, valid as long as this object is alive and unchanged
+		std::string_view get_name_view() const { return m_name; }
+
 		size_t get_num() const;
 	};
 
@@ -60,6 +66,9 @@ namespace MDR {
 
 		std::string get_metric_name() const;
 
+		// View of the metric name, valid as long as this object is alive and unchanged
+		std::string_view get_metric_name_view() const { return m_metric_id.get_name_view(); }
+
 		size_t get_metric_id() const;
 
 		// Get the minimize bool. If true, the dominance relation is choosing the
@@ -90,11 +99,19 @@ namespace MDR {
 		// Constructor for normal use
 		Design(const size_t& design_id);
 
+		// Designs are moved (never deep-copied) when a vector of designs is reallocated
+		Design(const Design&) = default;
+		Design(Design&&) noexcept = default;
+		Design& operator=(const Design&) = default;
+		Design& operator=(Design&&) noexcept = default;
+
 		// Add a performance metric to the existing metric vector
 		void add_perf_metric(const PerfMetric& perf_metric);
+		void add_perf_metric(PerfMetric&& perf_metric);
 
 		// Replace the existing metric vector with a specified performance metric vector
 		void set_perf_vector(const std::vector<PerfMetric>& perf_vector);
+		void set_perf_vector(std::vector<PerfMetric>&& perf_vector);
 
 		// Set the metrics which MDR will use to determine dominance relations
 		void set_active_perf_metrics(const size_t& active_perf_id_1, const size_t&
@@ -102,18 +119,36 @@ namespace MDR {
 
 		// Set the rank of the design
 		void set_ranks(const std::vector<size_t>& ranks);
+		void set_ranks(std::vector<size_t>&& ranks);
 
 		// Increase the rank value
 		void increase_rank_val(const size_t& idx) {
 			m_ranks[idx] += 1;
 		}
 
+		// Decrease the rank value
+		void decrease_rank_val(const size_t& idx) {
+			m_ranks[idx] -= 1;
+		}
+
+		// Given a metric id number, set the value of that performance metric. This function
+		// will return true if the operation is successful.
+		bool set_perf_val(const size_t& metric_id, const double& perf_val);
+
 		size_t get_design_id() const;
 
 		std::vector<PerfMetric> get_perf_vector() const;
 
+		// View of the metric vector, valid until the metrics of this design are changed
+		std::span<const PerfMetric> get_perf_vector_view() const { return m_perf_vector; }
+
 		std::vector<size_t> get_active_perf_metric_ids() const;
 
+		// Same as get_active_perf_metric_ids, without allocating a vector
+		std::array<size_t, 2> get_active_perf_metric_id_pair() const {
+			return { m_active_perf_id_1, m_active_perf_id_2 };
+		}
+
 		// Given a metric id number, give the value of that performance metric. Please note that
 		// the output (perf_val) is an argument of this function. This function will return true
 		// if the operation is successful.
@@ -131,6 +166,9 @@ namespace MDR {
 
 		// Get the rank of the design
 		std::vector<size_t> get_ranks() const;
+
+		// View of the ranks, valid until the ranks of this design are set again
+		std::span<const size_t> get_ranks_view() const { return m_ranks; }
 	};
 
 	class DomRel {
@@ -160,6 +198,12 @@ namespace MDR {
 		size_t operator [](int i) const { return m_perf_ids[i]; }
 		size_t& operator [](int i) { return m_perf_ids[i]; }
 	};
+
+	static_assert(std::is_nothrow_move_constructible_v<MetricID> &&
+		std::is_nothrow_move_constructible_v<PerfMetric> &&
+		std::is_nothrow_move_constructible_v<Design> &&
+		std::is_nothrow_move_assignable_v<Design>,
+		"Vectors of designs must move their elements when they grow");
 }
 
 #endif
@@ -0,0 +1,73 @@
+#ifndef MDR_FRONT_GENERATOR_H
+#define MDR_FRONT_GENERATOR_H
+
+#include <vector>
+#include <cstdint>
+
+#include "../headers/DesignClasses.h"
+
+namespace MDR {
+
+	// The code in this file is of my own design.
+	//
+	// Produces the successive fronts of a list of designs according to MDR, one at a time and
+	// only when asked: front 0 holds the designs which are not dominated, front 1 those only
+	// dominated by designs of front 0, and so on. If every remaining design is dominated (MDR
+	// can hold cycles), the designs dominated the minimum number of times make up the next
+	// front, as in find_pareto_front. No work is done for the fronts which are never asked for.
+	//
+	// A design is known to be dominated as soon as one dominating design is found, so the
+	// checks stop at the first one. The dominating design is remembered: while it has not
+	// been given a front, the design is still dominated and needs no check at all.
+	//
+	// Once a cycle is met, the dominations among the remaining designs are counted (once, in
+	// O(r^2) for r remaining designs). Each later front is then read from the counts, which
+	// are updated in O(r f) for a front of f designs, so deep cyclic fronts never recount
+	// every pair.
+
+	class FrontGenerator {
+		const std::vector<Design>* m_design_list = nullptr;
+		std::vector<DomRel> m_dom_rels;
+		size_t m_max_designs = 0;
+		size_t m_num_selected = 0;
+		size_t m_num_fronts = 0;
+		std::vector<size_t> m_remaining; // Index of the designs without a front, in order
+		std::vector<bool> m_selected;
+		std::vector<size_t> m_dominators; // Per design: last design found to dominate it
+		bool m_counting = false; // Whether a cycle has been met (m_dominations is in use)
+		std::vector<size_t> m_dominations; // Per design: remaining designs dominating it
+
+	public:
+		// Default constructor (constructs an empty object)
+		FrontGenerator() {}
+
+		// Intended constructor. The designs are not copied, so design_list must outlive the
+		// generator. Once max_designs designs have been selected, no further front is produced
+		// (the last front is always complete, so more designs may be selected). A max_designs
+		// of 0 means there is no such limit.
+		FrontGenerator(const std::vector<Design>& design_list, const std::vector<DomRel>& dom_rels,
+			const size_t& max_designs = 0);
+
+		// Find the indices (in ascending order) of the designs in the next front. This function
+		// will return false once every design has been given a front or max_designs designs
+		// have been selected. Please note that the output (front_ids) is an argument of this
+		// function.
+		bool next_ids(std::vector<size_t>& front_ids);
+
+		// Find the designs of the next front. See next_ids.
+		bool next(std::vector<Design>& front);
+
+		// Number of fronts produced so far
+		size_t get_num_fronts() const { return m_num_fronts; }
+
+		// Number of designs given a front so far
+		size_t get_num_selected() const { return m_num_selected; }
+	};
+
+	// Return the first fronts of a list of designs according to MDR, stopping once
+	// num_fronts fronts have been found or max_designs designs have been selected (if not 0).
+	std::vector<std::vector<Design>> find_first_fronts(const std::vector<Design>& design_list,
+		const std::vector<DomRel>& dom_rels, const size_t& num_fronts, const size_t& max_designs = 0);
+}
+
+#endif
@@ -0,0 +1,83 @@
+#ifndef MDR_FRONT_PRUNING_H
+#define MDR_FRONT_PRUNING_H
+
+#include <vector>
+#include <array>
+
+#include "../headers/DesignClasses.h"
+
+namespace MDR {
+
+	// The code in this file is of my own design, unless otherwise stated.
+	//
+	// Fronts found on anti-correlated metrics can hold most of the population. The functions
+	// below measure how much each design of a front adds to it, so a front can be reduced to
+	// a target size: either by crowding distance (how isolated a design is from its
+	// neighbours) or by hypervolume (the area dominated by the front in a pair of metrics).
+	//
+	// All values are direction corrected, so reference points are given in the same
+	// orientation as the metrics themselves (e.g. the worst acceptable value of each metric).
+	// Designs holding a NaN in the metrics used are given a crowding distance and a
+	// hypervolume contribution of 0.
+
+	// Methods understood by truncate_front
+	enum class TruncationMethod {
+		CrowdingDistance,	// Repeatedly remove the design with the smallest crowding distance
+		Hypervolume		// Repeatedly remove the design with the smallest hypervolume contribution
+	};
+
+	// Compute the crowding distance of every design of a front over a list of metrics, in
+	// O(k n log n) for k metrics. The designs at the ends of any metric are given an
+	// infinite distance. Please note that the output (distances) is an argument of this
+	// function.
+	//
+	// Crowding distance as defined in K. Deb, A. Pratap, S. Agarwal and T. Meyarivan,
+	// "A fast and elitist multiobjective genetic algorithm: NSGA-II", IEEE Transactions on
+	// Evolutionary Computation, vol. 6, no. 2, pp. 182-197, 2002.
+	void crowding_distances(const std::vector<Design>& front, const std::vector<size_t>& metric_ids,
+		std::vector<double>& distances);
+
+	// Return the area dominated by a front in the metrics of a dominance relation and bounded
+	// by a reference point, in O(n log n).
+	double hypervolume_2D(const std::vector<Design>& front, const DomRel& dom_rel,
+		const std::array<double, 2>& ref_point);
+
+	// Compute, in O(n log n), the hypervolume contribution of every design of a front: the
+	// area dominated by this design only. Designs which are dominated by (or equal to)
+	// another design contribute nothing; the contributions are exact for fronts in which no
+	// design is strictly dominated by another. Please note that the output (contributions)
+	// is an argument of this function.
+	void hypervolume_contributions_2D(const std::vector<Design>& front, const DomRel& dom_rel,
+		const std::array<double, 2>& ref_point, std::vector<double>& contributions);
+
+	// Reduce a front to target_size designs by crowding distance, computed over the metrics
+	// of every dominance relation. Only the distances of the neighbours of a removed design
+	// are updated, so the whole truncation takes O(k n log n).
+	std::vector<Design> truncate_front_crowding(const std::vector<Design>& front,
+		const std::vector<DomRel>& dom_rels, const size_t& target_size);
+
+	// Find a reference point for the metrics of a dominance relation: the worst finite value
+	// of each metric in the front, moved away from it by a tenth of the range of the metric
+	// (or by 1 if every design holds the same value). Every design with finite values is then
+	// strictly inside the reference box. This function will return false if no design holds
+	// finite values in both metrics. Please note that the output (ref_point) is an argument of
+	// this function.
+	bool find_reference_point(const std::vector<Design>& front, const DomRel& dom_rel,
+		std::array<double, 2>& ref_point);
+
+	// Reduce a front to target_size designs by hypervolume contribution in the metrics of a
+	// dominance relation, in O(n log n). The designs which contribute nothing are removed
+	// first. If fewer than target_size designs lie inside the reference box, they are all
+	// kept, and the others are chosen among the designs outside the box by their
+	// contributions to the reference point found by find_reference_point.
+	std::vector<Design> truncate_front_hypervolume(const std::vector<Design>& front,
+		const DomRel& dom_rel, const std::array<double, 2>& ref_point, const size_t& target_size);
+
+	// Reduce a front to target_size designs. The hypervolume is measured in the metrics of
+	// the first dominance relation, using ref_point (see find_reference_point).
+	std::vector<Design> truncate_front(const std::vector<Design>& front,
+		const std::vector<DomRel>& dom_rels, const size_t& target_size,
+		const TruncationMethod& method, const std::array<double, 2>& ref_point);
+}
+
+#endif
@@ -0,0 +1,101 @@
+#ifndef MDR_INCREMENTAL_RANKING_H
+#define MDR_INCREMENTAL_RANKING_H
+
+#include <vector>
+#include <set>
+#include <utility>
+#include <cstdint>
+
+#include "../headers/DesignClasses.h"
+
+namespace MDR {
+
+	// The code in this file is of my own design.
+	//
+	// A population whose ranks are kept up to date while designs are added and while the
+	// performance metrics of existing designs are changed (e.g. after re-evaluating a design
+	// with a higher fidelity simulation), instead of rerunning optimize_designs.
+	//
+	// The rank of a design in a layer is the number of designs dominating it in the
+	// dominance relation of that layer (as in update_ranks), and is stored in the ranks of
+	// the Design itself. The front of a layer holds the designs with a rank of 0. The number
+	// of times each design is dominated according to MDR is kept as well.
+	//
+	// Changing a metric of design C from an old to a new value can only change the way
+	// another design compares to C in that metric if its own value lies between the old
+	// and the new value (both included). Every metric is therefore kept sorted, and only the
+	// designs in that range are checked again against C. If the old or the new value is a
+	// NaN, every design has to be checked again.
+
+	class IncrementalRanking {
+		std::vector<Design> m_designs;
+		std::vector<DomRel> m_dom_rels;
+		std::vector<size_t> m_metric_ids; // Metrics used by the dominance relations
+		std::vector<std::set<std::pair<uint64_t, size_t>>> m_sorted; // Per metric: (key, design index)
+		std::vector<std::set<size_t>> m_fronts; // Per layer: index of the designs with a rank of 0
+		std::vector<size_t> m_dominations; // Per design: number of designs dominating it (MDR)
+		std::vector<bool> m_dirty;
+		std::vector<size_t> m_dirty_designs;
+		size_t m_num_checked = 0;
+
+		// Per layer relation between two designs: 0 if neither dominates, 1 if the first one
+		// dominates and 2 if the second one dominates
+		void find_relations(const size_t& first, const size_t& second,
+			std::vector<unsigned char>& relations) const;
+
+		// Update the ranks after the relations between two designs have changed
+		void update_relations(const size_t& first, const size_t& second,
+			const unsigned char* old_relations, const unsigned char* new_relations);
+
+		void increase_rank(const size_t& idx, const size_t& layer);
+
+		void decrease_rank(const size_t& idx, const size_t& layer);
+
+		void mark_dirty(const size_t& idx);
+
+	public:
+		// Default constructor (constructs an empty object)
+		IncrementalRanking() {}
+
+		// Intended constructor. Every design is added in turn, which takes O(n^2) checks.
+		IncrementalRanking(const std::vector<Design>& design_list, const std::vector<DomRel>& dom_rels);
+
+		// Add a design to the population, checking it against every existing design.
+		// Returns the index of the new design.
+		size_t add_design(const Design& design);
+
+		// Set the value of a performance metric of the design at index idx and update the ranks
+		// of the designs whose relation to it has changed. This function will return true if
+		// the operation is successful.
+		bool set_perf_val(const size_t& idx, const size_t& metric_id, const double& perf_val);
+
+		size_t size() const { return m_designs.size(); }
+
+		const Design& get_design(const size_t& idx) const { return m_designs[idx]; }
+
+		const std::vector<Design>& get_designs() const { return m_designs; }
+
+		const std::vector<DomRel>& get_dom_rels() const { return m_dom_rels; }
+
+		// Return the indices (in ascending order) of the designs with a rank of 0 in a layer
+		std::vector<size_t> get_front(const size_t& layer) const;
+
+		// Number of times each design is dominated according to MDR (as count_dominations)
+		const std::vector<size_t>& get_dominations() const { return m_dominations; }
+
+		// Return the indices (in ascending order) of the designs dominated the minimum number
+		// of times according to MDR (as find_pareto_front)
+		std::vector<size_t> get_mdr_front() const;
+
+		// Index of the designs whose ranks or MDR domination count have changed since the
+		// last call to clear_dirty (in the order they changed)
+		const std::vector<size_t>& get_dirty_designs() const { return m_dirty_designs; }
+
+		void clear_dirty();
+
+		// Number of designs checked again by the last call to add_design or set_perf_val
+		size_t get_num_checked() const { return m_num_checked; }
+	};
+}
+
+#endif
@@ -24,18 +24,6 @@ namespace MDR {
 	// of the above article.
 
 
-	// BEGIN DEPRECATED
-
-	//// DEPRECATED (Can still be used if necessary)
-	//
-	// // Find the set of pareto fronts given a list of designs and some dominance relations
-	// // A part of the combined implementations of Algorithms 2 and 4 from L. W. Cook et. al.
-	//std::vector<std::vector<Design>> optimize_designs(const std::vector<Design>& design_list,
-	//	const std::vector<DomRel>& dom_rels);
-
-	// END DEPRECATED
-
-
 	// Given two Designs A and B, return whether A dominates B in their active
 	// performance metrics (if both id1 and id2 are 0) or in the input metrics.
 	//
@@ -46,7 +34,7 @@ namespace MDR {
 	// Given two Designs A and B, return whether A dominates B given an order perf_ids.
 	// The perf_ids must hold an even number of ids
 	// MO concept from https://en.wikipedia.org/wiki/Multi-objective_optimization
-	bool A_dominates_B_MO(const Design& A, const Design& B, std::vector<size_t> perf_ids = {});
+	bool A_dominates_B_MO(const Design& A, const Design& B, const std::vector<size_t>& perf_ids = {});
 
 	// Check whether A dominates B according to MDR given a list of dominance relations
 	// Direct implementation of a Algorithm 3 from L. W. Cook et. al.
@@ -58,7 +46,45 @@ namespace MDR {
 	//
 	// Implementation of Algorithm 2 from L. W. Cook et. al.
 	void update_ranks(Design& new_design, std::vector<Design>& existing_designs,
-		std::vector<DomRel> id_order);
+		const std::vector<DomRel>& id_order);
+
+	// Given a list of designs and the metrics used by some dominance relations, group the
+	// designs which hold identical values in all of those metrics. On output,
+	// representatives holds the index of the first design of every group, multiplicities
+	// the size of each group and owners, for every design, the position of its group in
+	// representatives.
+	void collapse_duplicate_designs(const std::vector<Design>& design_list,
+		const std::vector<size_t>& metric_ids, std::vector<size_t>& representatives,
+		std::vector<size_t>& multiplicities, std::vector<size_t>& owners);
+
+	// Count the number of times each design of a list is dominated according to MDR given
+	// a list of dominance relations. Please note that the output (dominations) is an
+	// argument of this function.
+	//
+	// If collapse_duplicates is true, designs with identical values in the metrics of
+	// dom_rels are collapsed into a single representative before the dominance checks.
+	// The tallies are then expanded back, so they match those of the full list.
+	void count_dominations(const std::vector<Design>& design_list,
+		const std::vector<DomRel>& dom_rels, std::vector<size_t>& dominations,
+		const bool& collapse_duplicates = false);
+
+	// Returns the 2D pareto front within a list of designs and a set of dominance relations.
+	// See count_dominations for collapse_duplicates.
+	//
+	// A part of the combined implementations of Algorithms 2 and 4 from L. W. Cook et. al.
+	std::vector<Design> find_pareto_front(const std::vector<Design>& design_list,
+		const DomRel& dom_rel, const bool& collapse_duplicates = false);
+
+	// Find the set of pareto fronts given a list of designs and some dominance relations.
+	// The output can be written to disk with the functions in ResultWriters.h. The output
+	// starts with the whole list; each following front is the 2D pareto front of the
+	// previous one under dom_rels[0], dom_rels[2], and so on. FrontGenerator.h finds
+	// different layers (the successive fronts of the whole list according to MDR over every
+	// dominance relation), so it is not a lazy version of this function.
+	//
+	// A part of the combined implementations of Algorithms 2 and 4 from L. W. Cook et. al.
+	std::vector<std::vector<Design>> optimize_designs(const std::vector<Design>& design_list,
+		const std::vector<DomRel>& dom_rels, const bool& collapse_duplicates = false);
 }
 
 #endif
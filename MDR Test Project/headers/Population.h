@@ -0,0 +1,271 @@
+#ifndef MDR_POPULATION_H
+#define MDR_POPULATION_H
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <span>
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
+#include <limits>
+#include <cstdint>
+#include <assert.h>
+
+#include "../headers/DesignClasses.h"
+
+namespace MDR {
+
+	// The code in this file is of my own design.
+	//
+	// A Population stores the performance metrics of a list of designs column by column
+	// (one contiguous array per metric) instead of design by design. The value type T
+	// can be float or double: metrics which only carry a few significant digits can be
+	// stored as floats, which halves the memory traffic of the dominance kernels below
+	// and lets the compiler fit twice as many values in each SIMD register.
+	//
+	// All values are stored "direction corrected": metrics which are to be maximized are
+	// negated, so the kernels only ever have to check whether a value is the smaller one.
+
+	template <typename T = double>
+	class Population {
+		static_assert(std::is_floating_point<T>::value,
+			"Population values must be float or double");
+
+		std::vector<size_t> m_design_ids;
+		std::vector<size_t> m_metric_ids; // Metric id number of each column
+		std::vector<std::string> m_metric_names;
+		std::vector<bool> m_minimize;
+		std::vector<std::vector<T>> m_columns; // Direction corrected (always minimized)
+
+	public:
+		// Default constructor (constructs an empty object)
+		Population() {}
+
+		// Intended constructor
+		Population(const std::vector<Design>& designs) {
+			assign(designs);
+		}
+
+		// Replace the contents of the population with a list of designs. The columns are
+		// taken from the performance metrics of the first design. If T is narrower than
+		// double, a warning is reported for every metric in which two different values
+		// become equal once stored, and the total number of such collisions is returned.
+		size_t assign(const std::vector<Design>& designs) {
+			m_design_ids.clear();
+			m_metric_ids.clear();
+			m_metric_names.clear();
+			m_minimize.clear();
+			m_columns.clear();
+
+			if (designs.size() < 1) {
+				return 0;
+			}
+
+			for (const PerfMetric& metric : designs[0].get_perf_vector_view()) {
+				m_metric_ids.push_back(metric.get_metric_id());
+				m_metric_names.push_back(metric.get_metric_name());
+				m_minimize.push_back(metric.get_metric_minimize());
+			}
+			m_columns.resize(m_metric_ids.size());
+
+			m_design_ids.reserve(designs.size());
+			for (std::vector<T>& column : m_columns) {
+				column.reserve(designs.size());
+			}
+
+			for (const Design& design : designs) {
+				add_design(design);
+			}
+
+			return report_narrowing(designs);
+		}
+
+		// Add a design to the end of the population. The design must hold every metric of
+		// the population.
+		void add_design(const Design& design) {
+			const std::span<const PerfMetric> perf_vector = design.get_perf_vector_view();
+
+			for (size_t i = 0; i < m_columns.size(); i++) {
+				double val = 0;
+
+				// Designs normally hold their metrics in the same order as the columns
+				if (i < perf_vector.size() && perf_vector[i].get_metric_id() == m_metric_ids[i]) {
+					val = perf_vector[i].get_metric_val();
+				}
+				else {
+					const bool found = design.get_perf_val(m_metric_ids[i], val);
+					assert(found); // Check OK ID
+					(void)found;
+				}
+
+				m_columns[i].push_back(static_cast<T>(m_minimize[i] ? val : -val));
+			}
+
+			m_design_ids.push_back(design.get_design_id());
+		}
+
+		// Number of designs in the population
+		size_t size() const { return m_design_ids.size(); }
+
+		// Number of performance metrics (columns) of each design
+		size_t get_num_metrics() const { return m_columns.size(); }
+
+		size_t get_design_id(const size_t& idx) const { return m_design_ids[idx]; }
+
+		size_t get_metric_id(const size_t& col) const { return m_metric_ids[col]; }
+
+		const std::string& get_metric_name(const size_t& col) const { return m_metric_names[col]; }
+
+		bool get_minimize(const size_t& col) const { return m_minimize[col]; }
+
+		// Given a metric id number, find the column which stores it. Please note that the
+		// output (col) is an argument of this function. This function will return true if
+		// the operation is successful.
+		bool get_column_idx(const size_t& metric_id, size_t& col) const {
+			for (size_t i = 0; i < m_metric_ids.size(); i++) {
+				if (m_metric_ids[i] == metric_id) {
+					col = i;
+					return true;
+				}
+			}
+			return false;
+		}
+
+		// Return a direction corrected column (smaller values are always better)
+		const std::vector<T>& get_column(const size_t& col) const { return m_columns[col]; }
+
+		// Return the value of a performance metric as it was given (not direction corrected)
+		T get_val(const size_t& idx, const size_t& col) const {
+			return m_minimize[col] ? m_columns[col][idx] : -m_columns[col][idx];
+		}
+
+	private:
+		// Count (and report) the pairs of different values which compare equal once they
+		// have been narrowed to T.
+		size_t report_narrowing(const std::vector<Design>& designs) const {
+			if (std::is_same<T, double>::value || std::is_same<T, long double>::value) {
+				return 0;
+			}
+
+			size_t total_collisions = 0;
+			std::vector<double> values;
+
+			for (size_t col = 0; col < m_columns.size(); col++) {
+				values.clear();
+				for (const Design& design : designs) {
+					double val = 0;
+					if (design.get_perf_val(m_metric_ids[col], val) && !std::isnan(val)) {
+						values.push_back(val);
+					}
+				}
+
+				std::sort(values.begin(), values.end());
+				values.erase(std::unique(values.begin(), values.end()), values.end());
+
+				// Sorted distinct values only collide with their neighbours
+				size_t collisions = 0;
+				for (size_t i = 1; i < values.size(); i++) {
+					if (static_cast<T>(values[i - 1]) == static_cast<T>(values[i])) {
+						collisions++;
+					}
+				}
+
+				if (collisions > 0) {
+					std::cout << "Warning: " << collisions << " pair(s) of different values of metric \""
+						<< m_metric_names[col] << "\" compare equal in single precision" << std::endl;
+				}
+				total_collisions += collisions;
+			}
+
+			return total_collisions;
+		}
+	};
+
+	// Given two designs A and B (indices into a population), return whether A dominates B
+	// in the metrics of a dominance relation.
+	//
+	// Implement a binary relation from L. W. Cook et. al.
+	template <typename T>
+	bool A_dominates_B_2D(const Population<T>& population, const size_t& A, const size_t& B,
+		const DomRel& dom_rel) {
+
+		size_t first_col = 0;
+		size_t second_col = 0;
+		const bool found = population.get_column_idx(dom_rel[0], first_col) &&
+			population.get_column_idx(dom_rel[1], second_col);
+		assert(found); // Check OK ID
+		(void)found;
+
+		const std::vector<T>& first = population.get_column(first_col);
+		const std::vector<T>& second = population.get_column(second_col);
+
+		return first[A] < first[B] && second[A] < second[B];
+	}
+
+	// For every design of a population, count the number of designs which dominate it in
+	// the metrics of a dominance relation. The inner loop is branchless and runs over
+	// contiguous columns, so it is vectorised by the compiler. It counts into an integer as
+	// wide as T, so the comparison masks are never widened and floats get twice as many
+	// lanes as doubles.
+	template <typename T>
+	void count_dominations_2D(const Population<T>& population, const DomRel& dom_rel,
+		std::vector<size_t>& dominations) {
+
+		size_t first_col = 0;
+		size_t second_col = 0;
+		const bool found = population.get_column_idx(dom_rel[0], first_col) &&
+			population.get_column_idx(dom_rel[1], second_col);
+		assert(found); // Check OK ID
+		(void)found;
+
+		const T* first = population.get_column(first_col).data();
+		const T* second = population.get_column(second_col).data();
+		const size_t n = population.size();
+
+		dominations.assign(n, 0);
+
+		// The inner loop is split in blocks which the counter cannot overflow
+		typedef typename std::conditional<sizeof(T) <= sizeof(uint32_t), uint32_t, uint64_t>::type
+			Counter;
+		const size_t block_size = size_t(std::min<uint64_t>(std::numeric_limits<Counter>::max(),
+			std::numeric_limits<size_t>::max()));
+
+		for (size_t b = 0; b < n; b++) {
+			const T first_b = first[b];
+			const T second_b = second[b];
+
+			size_t count = 0;
+			for (size_t block = 0; block < n; block += std::min(block_size, n - block)) {
+				const size_t block_end = block + std::min(block_size, n - block);
+
+				Counter block_count = 0;
+				for (size_t a = block; a < block_end; a++) {
+					block_count += static_cast<Counter>((first[a] < first_b) & (second[a] < second_b));
+				}
+				count += block_count;
+			}
+			dominations[b] = count;
+		}
+	}
+
+	// Return the indices of the designs which are not dominated by any other design in the
+	// metrics of a dominance relation (the 2D pareto front of the population).
+	template <typename T>
+	std::vector<size_t> find_pareto_front_ids(const Population<T>& population,
+		const DomRel& dom_rel) {
+
+		std::vector<size_t> dominations;
+		count_dominations_2D(population, dom_rel, dominations);
+
+		std::vector<size_t> front_ids;
+		for (size_t i = 0; i < dominations.size(); i++) {
+			if (dominations[i] == 0) {
+				front_ids.push_back(i);
+			}
+		}
+		return front_ids;
+	}
+}
+
+#endif
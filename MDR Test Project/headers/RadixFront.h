@@ -0,0 +1,46 @@
+#ifndef MDR_RADIX_FRONT_H
+#define MDR_RADIX_FRONT_H
+
+#include <vector>
+#include <cstdint>
+
+#include "../headers/DesignClasses.h"
+
+namespace MDR {
+
+	// The code in this file is of my own design.
+	//
+	// For very large lists of designs, the 2D pareto front of a dominance relation is
+	// found by sorting the designs on their first metric and sweeping over them while
+	// keeping the best value of the second metric seen so far. To make the sort fast,
+	// every direction corrected value is first encoded as an unsigned 64 bit key whose
+	// integer order is the order of the values, and the keys are sorted with a parallel
+	// LSD radix sort. The result is the same as that of find_pareto_front (and therefore
+	// of A_dominates_B_2D): a design holding a NaN never dominates and is never dominated,
+	// and -0 and +0 compare equal.
+
+	// Key given to NaN values. NaNs are handled separately, this key only makes them sort last.
+	const uint64_t NAN_METRIC_KEY = UINT64_MAX;
+
+	// Encode a performance metric value as an order-preserving key. If minimize is false,
+	// the value is negated first, so smaller keys are always better.
+	uint64_t encode_metric_key(const double& val, const bool& minimize);
+
+	// Sort a list of keys in ascending order with a parallel LSD radix sort, applying the
+	// same permutation to ids. The sort is stable. If num_threads is 0, the number of
+	// hardware threads is used.
+	void radix_sort_keys(std::vector<uint64_t>& keys, std::vector<size_t>& ids,
+		size_t num_threads = 0);
+
+	// Return the indices (in ascending order) of the designs in the 2D pareto front of a
+	// dominance relation.
+	std::vector<size_t> find_pareto_front_radix_ids(const std::vector<Design>& design_list,
+		const DomRel& dom_rel, const size_t& num_threads = 0);
+
+	// Returns the 2D pareto front within a list of designs and a dominance relation, in the
+	// same order as find_pareto_front.
+	std::vector<Design> find_pareto_front_radix(const std::vector<Design>& design_list,
+		const DomRel& dom_rel, const size_t& num_threads = 0);
+}
+
+#endif
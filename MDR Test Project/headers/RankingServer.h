@@ -0,0 +1,130 @@
+#ifndef MDR_RANKING_SERVER_H
+#define MDR_RANKING_SERVER_H
+
+#include <vector>
+#include <string>
+#include <memory>
+#include <unordered_map>
+#include <mutex>
+#include <atomic>
+
+#include "../headers/DesignClasses.h"
+
+namespace MDR {
+
+	// The code in this file is of my own design.
+	//
+	// A RankingServer keeps a population of designs in memory and answers queries about it
+	// over a Unix domain socket, so analysis scripts do not need to re-read designs.csv and
+	// recompute the fronts for every question.
+	//
+	// The protocol is line based. A client may send any number of requests without waiting
+	// (pipelining); every request gets exactly one response line, in order, and all the
+	// responses to the requests read in one go are sent back together.
+	//
+	//   INSERT <id> <v1> ... <vm> [; <id> <v1> ... <vm>]...   ->  OK <number inserted>
+	//   RANK <design id> [<id1> <id2>]...                       ->  RANK <r1> <r2> ...
+	//   FRONT <k>                                               ->  FRONT <design ids>
+	//   DOMINATED <v1> ... <vm>                                 ->  DOMINATED <0 or 1>
+	//   SIZE                                                    ->  SIZE <number of designs>
+	//
+	// The values of INSERT and DOMINATED follow the order of the metrics of the initial
+	// designs. RANK gives, for every dominance relation of the list (or of the server if
+	// none is given), the number of designs dominating the design. FRONT gives the k-th
+	// front (starting from 1) under the dominance relations of the server, according to
+	// MDR. DOMINATED says whether a candidate is dominated by any design according to MDR.
+	// Design ids are unique: an INSERT holding an id already in use is rejected as a whole.
+	// Malformed requests are answered with "ERROR <message>".
+	//
+	// The server keeps, for every design, the number of designs dominating it according to
+	// MDR. An insert of b designs updates these counts in O(b n), so the first front is
+	// always known. Deeper fronts are peeled from the counts when first asked for, each in
+	// O(n f) for a front of f designs, and remembered until the next insert. The peel runs
+	// outside any lock, so concurrent FRONT queries never wait for one another.
+	//
+	// A single thread polls every connection and hands each batch of complete request lines
+	// to a pool of threads, so any number of clients can stay connected, idle or not. The
+	// next batch of a connection is only read once the previous one has been answered.
+	// Queries work on an immutable snapshot of the population, so they never wait for
+	// inserts: an insert publishes a new snapshot which shares every existing block of
+	// designs with the previous one.
+
+	class RankingServer {
+		// A connected client, as seen by the polling thread
+		struct ServerConnection {
+			std::string pending; // Received data which does not end a line yet
+			bool busy = false; // Whether a batch of its requests is being answered
+		};
+
+		// An immutable view of the population, made of blocks of designs
+		struct Snapshot {
+			std::vector<std::shared_ptr<const std::vector<Design>>> blocks;
+			size_t size = 0;
+			std::vector<const Design*> designs; // Every design, in insertion order
+			std::unordered_map<size_t, size_t> index_by_id; // Design id -> index in designs
+			// Per design: number of designs dominating it according to MDR. An insert carries
+			// the counts forward, only checking the pairs involving the new designs.
+			std::vector<size_t> dominations;
+
+			// Fronts found so far by FRONT queries (indices in designs), the designs without a
+			// front and, for each of them, the number of designs without a front dominating it
+			mutable std::mutex fronts_mutex; // Only held to read or publish the fronts
+			mutable std::vector<std::vector<size_t>> fronts;
+			mutable std::vector<size_t> remaining;
+			mutable std::vector<size_t> remaining_dominations;
+			mutable bool fronts_started = false;
+		};
+
+		std::vector<PerfMetric> m_metric_layout;
+		std::vector<DomRel> m_dom_rels;
+		size_t m_num_threads = 0;
+
+		std::mutex m_snapshot_mutex; // Only held while the snapshot pointer is read or replaced
+		std::shared_ptr<const Snapshot> m_snapshot;
+		std::mutex m_insert_mutex; // Serializes the inserts
+
+		std::atomic<bool> m_running{ false };
+
+	public:
+		// Intended constructor. The metrics of the first design set the order of the values
+		// given to INSERT and DOMINATED. If num_threads is 0, the number of hardware threads
+		// is used.
+		RankingServer(const std::vector<Design>& design_list, const std::vector<DomRel>& dom_rels,
+			const size_t& num_threads = 0);
+
+		// Listen on a Unix domain socket and serve clients until stop is called. This function
+		// will return false if the socket could not be set up.
+		bool run(const std::string& socket_path);
+
+		// Make run return (within a fraction of a second) once the batches already received
+		// have been answered. Every connection is then closed.
+		void stop();
+
+		// Answer a single request line (without the trailing newline)
+		std::string handle_request(const std::string& request);
+
+		// Answer every complete line of a batch of requests. The response lines are returned
+		// in order, each one followed by a newline.
+		std::string handle_batch(const std::string& requests);
+
+	private:
+		std::shared_ptr<const Snapshot> get_snapshot();
+
+		// Add a block of designs to the end of a snapshot, updating the domination counts
+		void add_block(Snapshot& snapshot, const std::shared_ptr<const std::vector<Design>>& block) const;
+
+		std::string handle_insert(const std::vector<std::string>& tokens);
+		std::string handle_rank(const std::vector<std::string>& tokens);
+		std::string handle_front(const std::vector<std::string>& tokens);
+
+		// Answer a FRONT query with the design ids of a front (nullptr if it does not exist)
+		std::string format_front(const Snapshot& snapshot, const std::vector<size_t>* front) const;
+		std::string handle_dominated(const std::vector<std::string>& tokens);
+
+		// Send the responses to a batch of requests. This function will return false if the
+		// client could not be written to.
+		bool send_responses(const int& connection, const std::string& responses);
+	};
+}
+
+#endif
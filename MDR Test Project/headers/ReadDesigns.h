@@ -6,6 +6,7 @@
 #include <vector>
 
 #include "../headers/DesignClasses.h"
+#include "../headers/Population.h"
 
 // The code in this file is of my own design unless otherwise stated
 
@@ -24,4 +25,18 @@ void split_string(const std::string& ip_string, const std::string& delim,
 void read_design_file(std::vector<MDR::Design>& design_list,
 	std::vector<MDR::MetricID>& metricid_list);
 
+// Reads a design file in this repo's proprietary format into a columnar population.
+// If the population stores floats, a warning is reported for every metric in which
+// narrowing the values makes two different values compare equal. Returns the number
+// of such collisions.
+template <typename T>
+size_t read_population_file(MDR::Population<T>& population,
+	std::vector<MDR::MetricID>& metricid_list) {
+
+	std::vector<MDR::Design> design_list;
+	read_design_file(design_list, metricid_list);
+
+	return population.assign(design_list);
+}
+
 #endif
@@ -0,0 +1,53 @@
+#ifndef MDR_RESULT_WRITERS_H
+#define MDR_RESULT_WRITERS_H
+
+#include <string>
+#include <vector>
+
+#include "../headers/DesignClasses.h"
+
+namespace MDR {
+
+	// The code in this file is of my own design. It writes the output of
+	// optimize_designs (a list of pareto front layers) to disk.
+	//
+	// Every writer streams the front layers in order and stores, for each design, the
+	// front layer it belongs to, its design id, the value of every performance metric
+	// and its per-layer ranks (as stored by update_ranks). The text formats are built
+	// in parallel in large batches before being handed to the output stream.
+
+	// Output formats understood by write_fronts
+	enum class FrontFormat {
+		CSV,			// One row per design, header with the metric names
+		Binary,		// Columnar binary format (see write_fronts_binary)
+		JSONLines	// One JSON object per design and per line
+	};
+
+	// Write a list of pareto fronts to "filename" in the requested format. If num_threads
+	// is 0, the number of hardware threads is used. This function will return true if the
+	// file was written successfully.
+	bool write_fronts(const std::vector<std::vector<Design>>& fronts,
+		const std::string& filename, const FrontFormat& format, const size_t& num_threads = 0);
+
+	// Write a list of pareto fronts as CSV. The header holds "front,design_id", the names
+	// of the performance metrics and one "rank_<layer>" column per dominance layer.
+	bool write_fronts_csv(const std::vector<std::vector<Design>>& fronts,
+		const std::string& filename, const size_t& num_threads = 0);
+
+	// Write a list of pareto fronts in the columnar binary format. All integers are 64 bit
+	// unsigned and all values are doubles, both in the native byte order:
+	//
+	//   "MDRF" | version | num_fronts | num_metrics | num_ranks
+	//   per metric: name length | name bytes | minimize (1 byte)
+	//   per front:  num_designs | design ids | one column per metric | one column per rank
+	bool write_fronts_binary(const std::vector<std::vector<Design>>& fronts,
+		const std::string& filename);
+
+	// Write a list of pareto fronts as JSON lines, one object per design:
+	// {"front":0,"design_id":3,"metrics":{"name":1.5,...},"ranks":[0,2]}
+	// Values which are not finite are written as null.
+	bool write_fronts_json(const std::vector<std::vector<Design>>& fronts,
+		const std::string& filename, const size_t& num_threads = 0);
+}
+
+#endif
@@ -0,0 +1,141 @@
+#ifndef MDR_SLIDING_WINDOW_ARCHIVE_H
+#define MDR_SLIDING_WINDOW_ARCHIVE_H
+
+#include <vector>
+#include <map>
+#include <array>
+#include <tuple>
+#include <cstdint>
+
+#include "../headers/DesignClasses.h"
+
+namespace MDR {
+
+	// The code in this file is of my own design.
+	//
+	// An archive of the 2D pareto fronts of a stream of designs, in which only the designs
+	// among the last max_designs inserted and evaluated at most max_age seconds ago are valid.
+	//
+	// In each layer (dominance relation) the archive only keeps the candidates: the designs
+	// which are not dominated by a newer design. A design dominated by a newer one can never
+	// be part of the front again, since it expires first. The front of a layer is then made
+	// of the candidates which are not dominated by another candidate. MDR is not transitive,
+	// so each layer is handled separately, and a design is stored as long as it is a
+	// candidate in one of the layers.
+	//
+	// The candidates of a layer are kept in a tree sorted by their first metric, in which each
+	// node also holds the worst second metric of its subtree. Inserting a design only visits
+	// the branches holding a candidate it dominates, in O((1 + d) log c) for c candidates of
+	// which d are dominated. Each design is removed at most once, so an insertion takes
+	// amortized O(log c) per layer. Expiring a design takes O(log c), and the front is found by
+	// a sweep over the candidates (in the order of their first metric) the first time it is
+	// requested after a change. The memory used is proportional to the number of candidates,
+	// not to the size of the window.
+
+	class SlidingWindowArchive {
+		// The candidates of a layer: a treap sorted by (first key, second key, insertion
+		// number), in which each node holds the largest second key of its subtree
+		class CandidateTree {
+			struct Node {
+				uint64_t first_key = 0;
+				uint64_t second_key = 0;
+				size_t number = 0;
+				uint64_t priority = 0;
+				size_t left = SIZE_MAX;
+				size_t right = SIZE_MAX;
+				uint64_t max_second_key = 0; // Over the designs of the subtree holding no NaN
+			};
+
+			std::vector<Node> m_nodes;
+			std::vector<size_t> m_free_nodes;
+			size_t m_root = SIZE_MAX;
+			size_t m_size = 0;
+
+			void update_max(const size_t& node);
+			// Split a subtree into the nodes before a key (or up to it if inclusive) and the rest
+			void split(const size_t& node, const uint64_t& first_key, const uint64_t& second_key,
+				const size_t& number, const bool& inclusive, size_t& before, size_t& after);
+			size_t merge(const size_t& before, const size_t& after);
+			void find_dominated(const size_t& node, const uint64_t& first_key,
+				const uint64_t& second_key, std::vector<size_t>& numbers) const;
+			void collect(const size_t& node,
+				std::vector<std::tuple<uint64_t, uint64_t, size_t>>& candidates) const;
+
+		public:
+			void insert(const uint64_t& first_key, const uint64_t& second_key, const size_t& number);
+			void erase(const uint64_t& first_key, const uint64_t& second_key, const size_t& number);
+
+			// Find the insertion numbers of the candidates with a larger first key and a larger
+			// second key (neither being a NaN). Please note that the output (numbers) is an
+			// argument of this function.
+			void find_dominated(const uint64_t& first_key, const uint64_t& second_key,
+				std::vector<size_t>& numbers) const;
+
+			// Store (first key, second key, insertion number) of every candidate, in order.
+			// Please note that the output (candidates) is an argument of this function.
+			void collect(std::vector<std::tuple<uint64_t, uint64_t, size_t>>& candidates) const;
+
+			size_t size() const { return m_size; }
+		};
+
+		// A design which is a candidate in at least one layer
+		struct ArchiveEntry {
+			Design design;
+			double timestamp = 0;
+			std::vector<std::array<uint64_t, 2>> keys; // Per layer: keys of the two metrics
+			std::vector<bool> candidate; // Per layer: whether the design is still a candidate
+			size_t num_candidate_layers = 0;
+		};
+
+		std::vector<DomRel> m_dom_rels;
+		size_t m_max_designs = 0;
+		double m_max_age = 0;
+		size_t m_num_inserted = 0;
+		double m_last_timestamp = 0;
+
+		std::map<size_t, ArchiveEntry> m_entries; // Stored designs by insertion number
+		std::vector<CandidateTree> m_candidates; // Per layer
+		std::vector<std::vector<size_t>> m_fronts; // Per layer: insertion numbers of the front
+		std::vector<bool> m_fronts_valid;
+
+		// Stop considering a design as a candidate in a layer. The design is not removed from
+		// m_entries, even if it is no longer a candidate in any layer.
+		void remove_candidate(ArchiveEntry& entry, const size_t& number, const size_t& layer);
+
+		// Remove the oldest stored design
+		void expire_oldest();
+
+		// Find the front of a layer among its candidates
+		void update_front(const size_t& layer);
+
+	public:
+		// Default constructor (constructs an empty object)
+		SlidingWindowArchive() {}
+
+		// Intended constructor. A max_designs or max_age of 0 means there is no such limit.
+		SlidingWindowArchive(const std::vector<DomRel>& dom_rels, const size_t& max_designs,
+			const double& max_age = 0);
+
+		// Insert the newest design of the stream, evaluated at time timestamp (in seconds).
+		// Timestamps must not decrease. The designs which leave the window are expired first.
+		// Returns the insertion number of the design.
+		size_t insert(const Design& design, const double& timestamp = 0);
+
+		// Expire the designs evaluated more than max_age seconds before now
+		void expire(const double& now);
+
+		// Returns the 2D pareto front of a layer within the current window, in insertion order
+		std::vector<Design> get_front(const size_t& layer);
+
+		// Number of candidates of a layer
+		size_t get_num_candidates(const size_t& layer) const { return m_candidates[layer].size(); }
+
+		// Number of designs stored by the archive
+		size_t get_num_stored() const { return m_entries.size(); }
+
+		// Number of designs inserted since the archive was constructed
+		size_t get_num_inserted() const { return m_num_inserted; }
+	};
+}
+
+#endif
@@ -0,0 +1,291 @@
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <assert.h>
+
+#include "../headers/DesignClasses.h"
+#include "../headers/MDRFunctions.h"
+#include "../headers/Population.h"
+#include "../headers/BitsetDominance.h"
+#include "../headers/RadixFront.h"
+#include "../headers/FrontGenerator.h"
+#include "../headers/AdaptiveFront.h"
+
+namespace MDR {
+
+	// The code in this file is of my own design.
+
+	// Below this number of designs, the pairwise loop is fastest
+	const size_t PAIRWISE_MAX_DESIGNS = 32;
+
+	// With several layers, the early exit peel is used if the front is at most this
+	// fraction of the designs and the metrics of the first layer are at least this
+	// correlated. Otherwise the bitset engine is used.
+	const double EARLY_EXIT_MAX_FRONT_FRACTION = 0.05;
+	const double EARLY_EXIT_MIN_CORRELATION = 0.5;
+
+	// With several layers, duplicates are collapsed (and the pairwise loop used) if at least
+	// this fraction of the sampled designs are equal to another sampled design
+	const double COLLAPSE_MIN_DUPLICATE_FRACTION = 0.5;
+
+	// From this number of designs, the sweep is split across threads
+	const size_t THREADED_SWEEP_MIN_DESIGNS = size_t(1) << 20;
+
+	const char* get_front_engine_name(const FrontEngine& engine) {
+		switch (engine) {
+		case FrontEngine::Auto:
+			return "Auto";
+		case FrontEngine::Pairwise:
+			return "Pairwise";
+		case FrontEngine::EarlyExit:
+			return "EarlyExit";
+		case FrontEngine::Sweep:
+			return "Sweep";
+		case FrontEngine::ThreadedSweep:
+			return "ThreadedSweep";
+		case FrontEngine::Bitset:
+			return "Bitset";
+		}
+		return "Unknown";
+	}
+
+	// Estimate the shape of a list of designs from an evenly spread sample
+	void sample_population_shape(const std::vector<Design>& design_list,
+		const std::vector<DomRel>& dom_rels, const size_t& sample_size, FrontEngineReport& report) {
+
+		const size_t n = design_list.size();
+		const size_t num_layers = dom_rels.size();
+		const size_t num_sampled = std::min(n, std::max<size_t>(1, sample_size));
+		if (n < 1) {
+			return;
+		}
+
+		// Direction corrected values of the sampled designs: two per layer
+		const size_t row_size = 2 * num_layers;
+		std::vector<double> vals(num_sampled * row_size);
+		for (size_t s = 0; s < num_sampled; s++) {
+			const Design& design = design_list[s * n / num_sampled];
+
+			for (size_t j = 0; j < num_layers; j++) {
+				for (int k = 0; k < 2; k++) {
+					double val = 0;
+					bool minimize = true;
+					const bool found = design.get_perf_val(dom_rels[j][k], val) &&
+						design.get_perf_minimize(dom_rels[j][k], minimize);
+					assert(found); // Check OK ID
+					(void)found;
+
+					vals[s * row_size + 2 * j + k] = minimize ? val : -val;
+				}
+			}
+		}
+		report.num_sampled = num_sampled;
+
+		// Fraction of the sample dominated the minimum number of times within the sample
+		// (as A_dominates_B_MDR, comparisons with a NaN are false)
+		auto dominates = [&vals, row_size, num_layers](const size_t& a, const size_t& b) {
+			const double* row_a = &vals[a * row_size];
+			const double* row_b = &vals[b * row_size];
+			for (size_t j = 0; j < num_layers; j++) {
+				if (row_a[2 * j] < row_b[2 * j] && row_a[2 * j + 1] < row_b[2 * j + 1]) {
+					return true;
+				}
+				if (row_b[2 * j] < row_a[2 * j] && row_b[2 * j + 1] < row_a[2 * j + 1]) {
+					return false;
+				}
+			}
+			return false;
+		};
+
+		std::vector<size_t> dominations(num_sampled, 0);
+		for (size_t i = 0; i < num_sampled; i++) {
+			for (size_t j = 0; j < num_sampled; j++) {
+				if (j != i && dominates(j, i)) {
+					dominations[i] += 1;
+				}
+			}
+		}
+		const size_t mindom = *std::min_element(dominations.begin(), dominations.end());
+		const size_t num_front = std::count(dominations.begin(), dominations.end(), mindom);
+		report.front_fraction = double(num_front) / double(num_sampled);
+		report.min_dominations = mindom;
+
+		// Pearson correlation of the finite values of the first layer
+		if (num_layers > 0) {
+			double sum_first = 0;
+			double sum_second = 0;
+			size_t num_finite = 0;
+			for (size_t i = 0; i < num_sampled; i++) {
+				const double* row = &vals[i * row_size];
+				if (std::isfinite(row[0]) && std::isfinite(row[1])) {
+					sum_first += row[0];
+					sum_second += row[1];
+					num_finite++;
+				}
+			}
+
+			if (num_finite > 1) {
+				const double mean_first = sum_first / double(num_finite);
+				const double mean_second = sum_second / double(num_finite);
+				double covariance = 0;
+				double var_first = 0;
+				double var_second = 0;
+				for (size_t i = 0; i < num_sampled; i++) {
+					const double* row = &vals[i * row_size];
+					if (std::isfinite(row[0]) && std::isfinite(row[1])) {
+						covariance += (row[0] - mean_first) * (row[1] - mean_second);
+						var_first += (row[0] - mean_first) * (row[0] - mean_first);
+						var_second += (row[1] - mean_second) * (row[1] - mean_second);
+					}
+				}
+				if (var_first > 0 && var_second > 0) {
+					report.correlation = covariance / std::sqrt(var_first * var_second);
+				}
+			}
+		}
+
+		// Fraction of the sample sharing every value with another sampled design
+		std::vector<std::vector<uint64_t>> keys(num_sampled, std::vector<uint64_t>(row_size));
+		for (size_t i = 0; i < num_sampled; i++) {
+			for (size_t c = 0; c < row_size; c++) {
+				keys[i][c] = encode_metric_key(vals[i * row_size + c], true);
+			}
+		}
+		std::sort(keys.begin(), keys.end());
+		size_t num_duplicates = 0;
+		for (size_t i = 0; i < num_sampled; i++) {
+			if ((i > 0 && keys[i - 1] == keys[i]) || (i + 1 < num_sampled && keys[i + 1] == keys[i])) {
+				num_duplicates++;
+			}
+		}
+		report.duplicate_fraction = double(num_duplicates) / double(num_sampled);
+	}
+
+	// Estimate the shape of a list of designs and choose an engine
+	FrontEngine choose_front_engine(const std::vector<Design>& design_list,
+		const std::vector<DomRel>& dom_rels, const FrontEngineOptions& options,
+		FrontEngineReport& report) {
+
+		const size_t n = design_list.size();
+		const bool is_sweep = options.engine == FrontEngine::Sweep ||
+			options.engine == FrontEngine::ThreadedSweep;
+		report.collapse_duplicates = options.collapse_duplicates;
+
+		if (options.engine != FrontEngine::Auto && (!is_sweep || dom_rels.size() == 1)) {
+			report.engine = options.engine;
+			return report.engine;
+		}
+
+		if (n <= PAIRWISE_MAX_DESIGNS) {
+			report.engine = FrontEngine::Pairwise;
+			return report.engine;
+		}
+
+		// The sweep does not depend on the shape of the population
+		if (dom_rels.size() == 1) {
+			report.engine = n >= THREADED_SWEEP_MIN_DESIGNS ? FrontEngine::ThreadedSweep :
+				FrontEngine::Sweep;
+			return report.engine;
+		}
+
+		sample_population_shape(design_list, dom_rels, options.sample_size, report);
+
+		// Many duplicates in a small sample means the list only holds a few distinct designs,
+		// so the pairwise loop only has a few representatives to check
+		if (report.duplicate_fraction >= COLLAPSE_MIN_DUPLICATE_FRACTION) {
+			report.engine = FrontEngine::Pairwise;
+			report.collapse_duplicates = true;
+		}
+		// The early exit peel falls back to counting every domination when every design is
+		// dominated (a cycle), which is likely for uncorrelated metrics
+		else if (report.front_fraction <= EARLY_EXIT_MAX_FRONT_FRACTION &&
+			report.min_dominations == 0 && report.correlation >= EARLY_EXIT_MIN_CORRELATION) {
+			report.engine = FrontEngine::EarlyExit;
+		}
+		else {
+			report.engine = FrontEngine::Bitset;
+		}
+
+		return report.engine;
+	}
+
+	// Returns the designs of a list dominated the minimum number of times according to MDR
+	std::vector<Design> find_pareto_front_adaptive(const std::vector<Design>& design_list,
+		const std::vector<DomRel>& dom_rels, const FrontEngineOptions& options,
+		FrontEngineReport& report) {
+
+		report = FrontEngineReport();
+		const FrontEngine engine = choose_front_engine(design_list, dom_rels, options, report);
+
+		const auto start = std::chrono::steady_clock::now();
+
+		std::vector<Design> pareto_front;
+		std::vector<size_t> dominations;
+		switch (engine) {
+		case FrontEngine::Auto:
+		case FrontEngine::Pairwise:
+			count_dominations(design_list, dom_rels, dominations, report.collapse_duplicates);
+			break;
+		case FrontEngine::EarlyExit: {
+			FrontGenerator generator(design_list, dom_rels);
+			generator.next(pareto_front);
+			break;
+		}
+		case FrontEngine::Sweep:
+			pareto_front = find_pareto_front_radix(design_list, dom_rels[0], 1);
+			break;
+		case FrontEngine::ThreadedSweep:
+			pareto_front = find_pareto_front_radix(design_list, dom_rels[0], options.num_threads);
+			break;
+		case FrontEngine::Bitset:
+			if (design_list.size() > 0) {
+				bitset_count_dominations(Population<double>(design_list), dom_rels, dominations);
+			}
+			break;
+		}
+
+		// The counting engines keep the designs dominated the minimum number of times
+		if (dominations.size() > 0) {
+			const size_t mindom = *std::min_element(dominations.begin(), dominations.end());
+			for (size_t i = 0; i < dominations.size(); i++) {
+				if (dominations[i] == mindom) {
+					pareto_front.push_back(design_list[i]);
+				}
+			}
+		}
+
+		report.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+		if (options.verbose) {
+			std::cout << "Front engine: " << get_front_engine_name(report.engine)
+				<< (report.collapse_duplicates ? " (duplicates collapsed)" : "")
+				<< ", " << design_list.size() << " designs, " << dom_rels.size() << " layer(s)";
+			if (report.num_sampled > 0) {
+				std::cout << ", sampled " << report.num_sampled
+					<< " (front " << 100 * report.front_fraction << "%"
+					<< ", dominated at least " << report.min_dominations << " time(s)"
+					<< ", correlation " << report.correlation
+					<< ", duplicates " << 100 * report.duplicate_fraction << "%)";
+			}
+			std::cout << ", " << pareto_front.size() << " in front, took "
+				<< report.seconds << " s" << std::endl;
+		}
+
+		return pareto_front;
+	}
+
+	std::vector<Design> find_pareto_front_adaptive(const std::vector<Design>& design_list,
+		const std::vector<DomRel>& dom_rels, const FrontEngineOptions& options) {
+		FrontEngineReport report;
+		return find_pareto_front_adaptive(design_list, dom_rels, options, report);
+	}
+
+	// Returns the 2D pareto front within a list of designs and a dominance relation
+	std::vector<Design> find_pareto_front_adaptive(const std::vector<Design>& design_list,
+		const DomRel& dom_rel, const FrontEngineOptions& options) {
+		return find_pareto_front_adaptive(design_list, std::vector<DomRel>{ dom_rel }, options);
+	}
+}
@@ -0,0 +1,336 @@
+#include <vector>
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <assert.h>
+
+#include "../headers/DesignClasses.h"
+#include "../headers/Population.h"
+#include "../headers/BitsetDominance.h"
+
+namespace MDR {
+
+	// The code in this file is of my own design.
+
+	const size_t BITS_PER_WORD = 64;
+
+	// A metric column prepared for building bitsets
+	struct BitsetColumn {
+		std::vector<size_t> order; // Designs without a NaN, sorted by value
+		std::vector<size_t> smaller_count; // Per design: number of designs with a smaller value
+		std::vector<size_t> not_larger_count; // Per design: number of designs with a value not larger
+		std::vector<uint64_t> valid; // Bitset of the designs without a NaN
+	};
+
+	// Sort a direction corrected column and count, for every design, how many designs are
+	// strictly better and how many are not worse. A design holding a NaN is neither better
+	// nor worse than any other design.
+	template <typename T>
+	void build_bitset_column(const std::vector<T>& column, const size_t& words, BitsetColumn& result) {
+		const size_t n = column.size();
+
+		result.order.clear();
+		result.valid.assign(words, 0);
+		for (size_t i = 0; i < n; i++) {
+			if (!std::isnan(column[i])) {
+				result.order.push_back(i);
+				result.valid[i / BITS_PER_WORD] |= uint64_t(1) << (i % BITS_PER_WORD);
+			}
+		}
+
+		std::sort(result.order.begin(), result.order.end(),
+			[&column](const size_t& a, const size_t& b) { return column[a] < column[b]; });
+
+		const size_t num_valid = result.order.size();
+		result.smaller_count.assign(n, 0);
+		result.not_larger_count.assign(n, num_valid); // A NaN is not better than anything
+
+		size_t group_begin = 0;
+		while (group_begin < num_valid) {
+			size_t group_end = group_begin;
+			while (group_end < num_valid &&
+				column[result.order[group_end]] == column[result.order[group_begin]]) {
+				group_end++;
+			}
+			for (size_t j = group_begin; j < group_end; j++) {
+				result.smaller_count[result.order[j]] = group_begin;
+				result.not_larger_count[result.order[j]] = group_end;
+			}
+			group_begin = group_end;
+		}
+	}
+
+	// Walk along the sorted order of a column, building the bitset of the designs seen so far.
+	// Each design of the block [block_begin, block_end) gets combine(row, prefix) called on
+	// its row once the prefix holds the first thresholds[design] designs of the order.
+	template <typename Combine>
+	void walk_prefixes(const BitsetColumn& column, const std::vector<size_t>& thresholds,
+		const size_t& block_begin, const size_t& block_end, const size_t& words,
+		std::vector<size_t>& block_order, std::vector<uint64_t>& prefix,
+		std::vector<uint64_t>& rows, const Combine& combine) {
+
+		block_order.resize(block_end - block_begin);
+		for (size_t k = 0; k < block_order.size(); k++) {
+			block_order[k] = block_begin + k;
+		}
+		std::sort(block_order.begin(), block_order.end(),
+			[&thresholds](const size_t& a, const size_t& b) { return thresholds[a] < thresholds[b]; });
+
+		std::fill(prefix.begin(), prefix.end(), 0);
+		size_t pos = 0;
+
+		for (const size_t& design : block_order) {
+			while (pos < thresholds[design]) {
+				const size_t other = column.order[pos];
+				prefix[other / BITS_PER_WORD] |= uint64_t(1) << (other % BITS_PER_WORD);
+				pos++;
+			}
+			combine(&rows[(design - block_begin) * words], prefix.data());
+		}
+	}
+
+	// Prepared data shared by the blocks of a population
+	struct BitsetEngineData {
+		size_t n = 0;
+		size_t words = 0;
+		size_t block_size = 0;
+		std::vector<BitsetColumn> columns;
+		std::vector<std::array<size_t, 2>> layers; // Index in columns of the metrics of each layer
+	};
+
+	template <typename T>
+	void prepare_bitset_engine(const Population<T>& population, const std::vector<DomRel>& dom_rels,
+		const size_t& memory_budget, const size_t& rows_per_design, BitsetEngineData& data) {
+
+		data.n = population.size();
+		data.words = (data.n + BITS_PER_WORD - 1) / BITS_PER_WORD;
+
+		// Each block needs rows_per_design bitsets per design
+		const size_t bytes_per_design = std::max<size_t>(1, rows_per_design * data.words * sizeof(uint64_t));
+		data.block_size = std::max(BITS_PER_WORD,
+			(memory_budget / bytes_per_design) / BITS_PER_WORD * BITS_PER_WORD);
+		data.block_size = std::min(data.block_size, std::max<size_t>(1, data.n));
+
+		// Prepare every column used by the dominance relations once
+		std::vector<size_t> column_ids;
+		for (const DomRel& dom_rel : dom_rels) {
+			std::array<size_t, 2> layer{ { 0, 0 } };
+
+			for (int k = 0; k < 2; k++) {
+				size_t col = 0;
+				const bool found = population.get_column_idx(dom_rel[k], col);
+				assert(found); // Check OK ID
+				(void)found;
+
+				const auto known = std::find(column_ids.begin(), column_ids.end(), col);
+				layer[k] = known - column_ids.begin();
+				if (known == column_ids.end()) {
+					column_ids.push_back(col);
+					data.columns.emplace_back();
+					build_bitset_column(population.get_column(col), data.words, data.columns.back());
+				}
+			}
+
+			data.layers.push_back(layer);
+		}
+	}
+
+	// Build the bitsets of the designs dominating each design of the block [block_begin,
+	// block_end). dominators holds one row of data.words words per design of the block.
+	void compute_dominator_block(const BitsetEngineData& data, const BitsetRelation& relation,
+		const size_t& block_begin, const size_t& block_end, std::vector<uint64_t>& dominators) {
+
+		const size_t words = data.words;
+		const size_t rows_size = (block_end - block_begin) * words;
+
+		std::vector<uint64_t> better(rows_size);
+		std::vector<uint64_t> worse(rows_size);
+		std::vector<uint64_t> undecided(rows_size, ~uint64_t(0));
+		std::vector<uint64_t> prefix(words);
+		std::vector<size_t> block_order;
+
+		dominators.assign(rows_size, 0);
+
+		auto copy = [words](uint64_t* row, const uint64_t* bits) {
+			for (size_t w = 0; w < words; w++) {
+				row[w] = bits[w];
+			}
+		};
+		auto intersect = [words](uint64_t* row, const uint64_t* bits) {
+			for (size_t w = 0; w < words; w++) {
+				row[w] &= bits[w];
+			}
+		};
+
+		for (size_t l = 0; l < data.layers.size(); l++) {
+			const BitsetColumn& first = data.columns[data.layers[l][0]];
+			const BitsetColumn& second = data.columns[data.layers[l][1]];
+
+			// Designs strictly better in both metrics (a prefix of each sorted column)
+			walk_prefixes(first, first.smaller_count, block_begin, block_end, words, block_order,
+				prefix, better, copy);
+			walk_prefixes(second, second.smaller_count, block_begin, block_end, words, block_order,
+				prefix, better, intersect);
+
+			if (relation == BitsetRelation::MO) {
+				// A must dominate B in every layer
+				if (l == 0) {
+					dominators = better;
+				}
+				else {
+					for (size_t w = 0; w < rows_size; w++) {
+						dominators[w] &= better[w];
+					}
+				}
+				continue;
+			}
+
+			// Designs strictly worse in both metrics (valid designs outside the prefix of the
+			// designs which are not worse)
+			const uint64_t* first_valid = first.valid.data();
+			const uint64_t* second_valid = second.valid.data();
+			walk_prefixes(first, first.not_larger_count, block_begin, block_end, words, block_order,
+				prefix, worse, [words, first_valid](uint64_t* row, const uint64_t* bits) {
+					for (size_t w = 0; w < words; w++) {
+						row[w] = first_valid[w] & ~bits[w];
+					}
+				});
+			walk_prefixes(second, second.not_larger_count, block_begin, block_end, words, block_order,
+				prefix, worse, [words, second_valid](uint64_t* row, const uint64_t* bits) {
+					for (size_t w = 0; w < words; w++) {
+						row[w] &= second_valid[w] & ~bits[w];
+					}
+				});
+
+			// The first layer in which two designs can be told apart decides (MDR)
+			for (size_t w = 0; w < rows_size; w++) {
+				dominators[w] |= undecided[w] & better[w];
+				undecided[w] &= ~better[w] & ~worse[w];
+			}
+		}
+	}
+
+	template <typename T>
+	void bitset_count_dominations(const Population<T>& population,
+		const std::vector<DomRel>& dom_rels, std::vector<size_t>& dominations,
+		const BitsetRelation& relation, const size_t& memory_budget) {
+
+		BitsetEngineData data;
+		prepare_bitset_engine(population, dom_rels, memory_budget, 4, data);
+
+		dominations.assign(data.n, 0);
+		if (dom_rels.size() < 1) {
+			return;
+		}
+
+		std::vector<uint64_t> dominators;
+		for (size_t block_begin = 0; block_begin < data.n; block_begin += data.block_size) {
+			const size_t block_end = std::min(data.n, block_begin + data.block_size);
+			compute_dominator_block(data, relation, block_begin, block_end, dominators);
+
+			for (size_t i = block_begin; i < block_end; i++) {
+				const uint64_t* row = &dominators[(i - block_begin) * data.words];
+				size_t count = 0;
+				for (size_t w = 0; w < data.words; w++) {
+					count += std::popcount(row[w]);
+				}
+				dominations[i] = count;
+			}
+		}
+	}
+
+	template <typename T>
+	void bitset_front_indices(const Population<T>& population,
+		const std::vector<DomRel>& dom_rels, std::vector<size_t>& front_ids,
+		const BitsetRelation& relation, const size_t& memory_budget) {
+
+		BitsetEngineData data;
+		prepare_bitset_engine(population, dom_rels, memory_budget, 4, data);
+
+		const size_t n = data.n;
+		const size_t words = data.words;
+		front_ids.assign(n, 0);
+		if (n < 1 || dom_rels.size() < 1) {
+			return;
+		}
+
+		// Keep every dominator set if they fit in half of the budget, otherwise rebuild them
+		// block by block for every front
+		const bool keep_all = n * words * sizeof(uint64_t) <= memory_budget / 2;
+		std::vector<uint64_t> all_dominators;
+		if (keep_all) {
+			all_dominators.resize(n * words);
+			std::vector<uint64_t> dominators;
+			for (size_t block_begin = 0; block_begin < n; block_begin += data.block_size) {
+				const size_t block_end = std::min(n, block_begin + data.block_size);
+				compute_dominator_block(data, relation, block_begin, block_end, dominators);
+				std::copy(dominators.begin(), dominators.end(), all_dominators.begin() + block_begin * words);
+			}
+		}
+
+		std::vector<uint64_t> unassigned(words, 0);
+		for (size_t i = 0; i < n; i++) {
+			unassigned[i / BITS_PER_WORD] |= uint64_t(1) << (i % BITS_PER_WORD);
+		}
+		std::vector<bool> assigned(n, false);
+		std::vector<size_t> counts(n, 0);
+		std::vector<uint64_t> dominators;
+		size_t num_assigned = 0;
+
+		for (size_t front = 0; num_assigned < n; front++) {
+			// Count the unassigned designs dominating each unassigned design
+			size_t min_count = n;
+			for (size_t block_begin = 0; block_begin < n; block_begin += data.block_size) {
+				const size_t block_end = std::min(n, block_begin + data.block_size);
+
+				const uint64_t* rows = nullptr;
+				if (keep_all) {
+					rows = &all_dominators[block_begin * words];
+				}
+				else {
+					compute_dominator_block(data, relation, block_begin, block_end, dominators);
+					rows = dominators.data();
+				}
+
+				for (size_t i = block_begin; i < block_end; i++) {
+					if (assigned[i]) {
+						continue;
+					}
+					const uint64_t* row = rows + (i - block_begin) * words;
+					size_t count = 0;
+					for (size_t w = 0; w < words; w++) {
+						count += std::popcount(row[w] & unassigned[w]);
+					}
+					counts[i] = count;
+					min_count = std::min(min_count, count);
+				}
+			}
+
+			// The designs dominated the minimum number of times (normally 0) form the front
+			for (size_t i = 0; i < n; i++) {
+				if (!assigned[i] && counts[i] == min_count) {
+					front_ids[i] = front;
+					assigned[i] = true;
+					num_assigned++;
+				}
+			}
+			for (size_t i = 0; i < n; i++) {
+				if (assigned[i]) {
+					unassigned[i / BITS_PER_WORD] &= ~(uint64_t(1) << (i % BITS_PER_WORD));
+				}
+			}
+		}
+	}
+
+	// The engine is compiled for both storage modes of Population
+	template void bitset_count_dominations<float>(const Population<float>&,
+		const std::vector<DomRel>&, std::vector<size_t>&, const BitsetRelation&, const size_t&);
+	template void bitset_count_dominations<double>(const Population<double>&,
+		const std::vector<DomRel>&, std::vector<size_t>&, const BitsetRelation&, const size_t&);
+	template void bitset_front_indices<float>(const Population<float>&,
+		const std::vector<DomRel>&, std::vector<size_t>&, const BitsetRelation&, const size_t&);
+	template void bitset_front_indices<double>(const Population<double>&,
+		const std::vector<DomRel>&, std::vector<size_t>&, const BitsetRelation&, const size_t&);
+}
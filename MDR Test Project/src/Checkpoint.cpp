@@ -0,0 +1,737 @@
+#include <vector>
+#include <string>
+#include <string_view>
+#include <span>
+#include <fstream>
+#include <filesystem>
+#include <unordered_map>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "../headers/DesignClasses.h"
+#include "../headers/Checkpoint.h"
+
+namespace MDR {
+
+	// The code in this file is of my own design.
+	//
+	// File layout (every field is a 64 bit word):
+	//
+	//   header:  magic | version | offset of the latest state or delta | reserved
+	//   record:  type | number of payload words | payload
+	//
+	//   rows payload:  row_begin | row_count | num_metrics | design ids[row_count]
+	//                  | values[num_metrics][row_count] (doubles)
+	//   state payload: num_designs | num_metrics | num_layers | num_segments
+	//                  | metric ids[num_metrics] | minimize[num_metrics]
+	//                  | dom_rels[num_layers][2] | rows record offsets[num_segments]
+	//                  | ranks[num_designs][num_layers] | front ids[num_designs]
+	//                  | per metric: name length | name bytes padded to a whole word
+	//   delta payload: offset of the previous state or delta | num_designs
+	//                  | offset of the rows record of the new designs (0 if none) | num_entries
+	//                  | per entry: design index | ranks[num_layers] | front id
+
+	const char CHECKPOINT_MAGIC[8] = { 'M', 'D', 'R', 'C', 'K', 'P', 'T', '1' };
+	const uint64_t CHECKPOINT_VERSION = 1;
+	const uint64_t CHECKPOINT_HEADER_WORDS = 4;
+	const uint64_t CHECKPOINT_HEAD_OFFSET_POS = 2 * sizeof(uint64_t);
+
+	const uint64_t CHECKPOINT_ROWS_RECORD = 1;
+	const uint64_t CHECKPOINT_STATE_RECORD = 2;
+	const uint64_t CHECKPOINT_DELTA_RECORD = 3;
+
+	// Compact once the latest state is followed by more deltas than this
+	const size_t CHECKPOINT_MAX_DELTAS = 32;
+
+	// Return the performance metrics stored by a checkpoint, taken from the first design
+	std::vector<PerfMetric> find_checkpoint_layout(const std::vector<Design>& design_list) {
+		if (design_list.size() > 0) {
+			return design_list[0].get_perf_vector();
+		}
+		return {};
+	}
+
+	uint64_t double_to_word(const double& val) {
+		uint64_t word = 0;
+		std::memcpy(&word, &val, sizeof(word));
+		return word;
+	}
+
+	// Append a rows record holding the designs in [row_begin, row_end) to a list of words
+	void build_rows_record(const std::vector<Design>& design_list,
+		const std::vector<PerfMetric>& layout, const size_t& row_begin, const size_t& row_end,
+		std::vector<uint64_t>& words) {
+
+		const size_t row_count = row_end - row_begin;
+		const size_t num_metrics = layout.size();
+
+		words.push_back(CHECKPOINT_ROWS_RECORD);
+		words.push_back(3 + row_count * (1 + num_metrics));
+		words.push_back(row_begin);
+		words.push_back(row_count);
+		words.push_back(num_metrics);
+
+		for (size_t i = row_begin; i < row_end; i++) {
+			words.push_back(design_list[i].get_design_id());
+		}
+
+		const size_t values_begin = words.size();
+		words.resize(values_begin + row_count * num_metrics, 0);
+
+		for (size_t i = row_begin; i < row_end; i++) {
+			const std::span<const PerfMetric> perf_vector = design_list[i].get_perf_vector_view();
+
+			for (size_t m = 0; m < num_metrics; m++) {
+				double val = 0;
+				if (m < perf_vector.size() &&
+					perf_vector[m].get_metric_id() == layout[m].get_metric_id()) {
+					val = perf_vector[m].get_metric_val();
+				}
+				else {
+					design_list[i].get_perf_val(layout[m].get_metric_id(), val);
+				}
+				words[values_begin + m * row_count + (i - row_begin)] = double_to_word(val);
+			}
+		}
+	}
+
+	// Flatten the dominance relations stored by a checkpoint
+	std::vector<uint64_t> flatten_dom_rels(const std::vector<DomRel>& dom_rels) {
+		std::vector<uint64_t> words;
+		for (const DomRel& dom_rel : dom_rels) {
+			words.push_back(dom_rel[0]);
+			words.push_back(dom_rel[1]);
+		}
+		return words;
+	}
+
+	// Flatten the ranks (num_layers per design) and the front ids stored by a checkpoint.
+	// Designs with fewer ranks than dominance layers are given a rank of 0.
+	void find_checkpoint_ranks(const std::vector<Design>& design_list, const size_t& num_layers,
+		const std::vector<size_t>& front_ids, std::vector<uint64_t>& ranks,
+		std::vector<uint64_t>& fronts) {
+
+		ranks.clear();
+		ranks.reserve(design_list.size() * num_layers);
+		for (const Design& design : design_list) {
+			const std::span<const size_t> design_ranks = design.get_ranks_view();
+			for (size_t j = 0; j < num_layers; j++) {
+				ranks.push_back(j < design_ranks.size() ? design_ranks[j] : 0);
+			}
+		}
+
+		fronts.assign(design_list.size(), 0);
+		for (size_t i = 0; i < design_list.size() && i < front_ids.size(); i++) {
+			fronts[i] = front_ids[i];
+		}
+	}
+
+	// Append a state record to a list of words
+	void build_state_record(const std::vector<PerfMetric>& layout,
+		const std::vector<uint64_t>& dom_rels, const std::vector<uint64_t>& ranks,
+		const std::vector<uint64_t>& fronts, const std::vector<uint64_t>& segments,
+		std::vector<uint64_t>& words) {
+
+		const size_t record_begin = words.size();
+
+		words.push_back(CHECKPOINT_STATE_RECORD);
+		words.push_back(0); // Filled in below
+		words.push_back(fronts.size());
+		words.push_back(layout.size());
+		words.push_back(dom_rels.size() / 2);
+		words.push_back(segments.size());
+
+		for (const PerfMetric& metric : layout) {
+			words.push_back(metric.get_metric_id());
+		}
+		for (const PerfMetric& metric : layout) {
+			words.push_back(metric.get_metric_minimize() ? 1 : 0);
+		}
+		words.insert(words.end(), dom_rels.begin(), dom_rels.end());
+		words.insert(words.end(), segments.begin(), segments.end());
+		words.insert(words.end(), ranks.begin(), ranks.end());
+		words.insert(words.end(), fronts.begin(), fronts.end());
+
+		for (const PerfMetric& metric : layout) {
+			const std::string_view name = metric.get_metric_name_view();
+			const size_t name_words = (name.size() + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+			words.push_back(name.size());
+			const size_t name_begin = words.size();
+			words.resize(name_begin + name_words, 0);
+			if (name.size() > 0) {
+				std::memcpy(&words[name_begin], name.data(), name.size());
+			}
+		}
+
+		words[record_begin + 1] = words.size() - record_begin - 2;
+	}
+
+	// Append a delta record to a list of words, holding the designs whose ranks or front
+	// differ from the previous ones (new designs always do). Return the number of entries.
+	size_t build_delta_record(const uint64_t& prev_offset, const uint64_t& rows_offset,
+		const size_t& num_layers, const std::vector<uint64_t>& prev_ranks,
+		const std::vector<uint64_t>& prev_fronts, const std::vector<uint64_t>& ranks,
+		const std::vector<uint64_t>& fronts, std::vector<uint64_t>& words) {
+
+		const size_t record_begin = words.size();
+
+		words.push_back(CHECKPOINT_DELTA_RECORD);
+		words.push_back(0); // Filled in below
+		words.push_back(prev_offset);
+		words.push_back(fronts.size());
+		words.push_back(rows_offset);
+		words.push_back(0); // Filled in below
+
+		size_t num_entries = 0;
+		for (size_t i = 0; i < fronts.size(); i++) {
+			const auto design_ranks = ranks.begin() + i * num_layers;
+			if (i < prev_fronts.size() && prev_fronts[i] == fronts[i] &&
+				std::equal(design_ranks, design_ranks + num_layers, prev_ranks.begin() + i * num_layers)) {
+				continue;
+			}
+
+			words.push_back(i);
+			words.insert(words.end(), design_ranks, design_ranks + num_layers);
+			words.push_back(fronts[i]);
+			num_entries++;
+		}
+
+		words[record_begin + 1] = words.size() - record_begin - 2;
+		words[record_begin + 5] = num_entries;
+		return num_entries;
+	}
+
+	bool write_words(std::ostream& file, const std::vector<uint64_t>& words) {
+		file.write(reinterpret_cast<const char*>(words.data()), words.size() * sizeof(uint64_t));
+		return file.good();
+	}
+
+	// Given the output of optimize_designs, find the deepest front containing each design
+	void find_front_ids(const std::vector<Design>& design_list,
+		const std::vector<std::vector<Design>>& fronts, std::vector<size_t>& front_ids) {
+
+		std::unordered_map<size_t, size_t> design_idx;
+		for (size_t i = 0; i < design_list.size(); i++) {
+			design_idx[design_list[i].get_design_id()] = i;
+		}
+
+		front_ids.assign(design_list.size(), 0);
+		for (size_t k = 0; k < fronts.size(); k++) {
+			for (const Design& design : fronts[k]) {
+				const auto found = design_idx.find(design.get_design_id());
+				if (found != design_idx.end()) {
+					front_ids[found->second] = std::max(front_ids[found->second], k);
+				}
+			}
+		}
+	}
+
+	/* CHECKPOINT WRITER FUNCTIONS*/
+
+	bool CheckpointWriter::open(const std::string& filename) {
+		m_filename = filename;
+		m_file_size = 0;
+		m_head_offset = 0;
+		m_num_deltas = 0;
+		m_rows_written = 0;
+		m_rows_changed = false;
+		m_dom_rels.clear();
+		m_ranks.clear();
+		m_front_ids.clear();
+
+		std::error_code error;
+		if (!std::filesystem::exists(filename, error)) {
+			// Nothing to resume, the file is created by the first append
+			return true;
+		}
+
+		CheckpointReader reader;
+		if (!reader.open(filename)) {
+			return false;
+		}
+
+		m_file_size = reader.get_file_size();
+		m_head_offset = reader.get_head_offset();
+		m_num_deltas = reader.get_num_deltas();
+		m_rows_written = reader.size();
+		m_dom_rels = flatten_dom_rels(reader.get_dom_rels());
+
+		const size_t num_layers = reader.get_num_layers();
+		m_ranks.reserve(reader.size() * num_layers);
+		m_front_ids.reserve(reader.size());
+		for (size_t i = 0; i < reader.size(); i++) {
+			for (size_t j = 0; j < num_layers; j++) {
+				m_ranks.push_back(reader.get_rank(i, j));
+			}
+			m_front_ids.push_back(reader.get_front_id(i));
+		}
+		return true;
+	}
+
+	bool CheckpointWriter::append(const std::vector<Design>& design_list,
+		const std::vector<DomRel>& dom_rels, const std::vector<size_t>& front_ids) {
+
+		// Start from scratch if there is nothing to append to, designs were removed, written
+		// rows have changed or the dominance relations differ from the ones of the latest state
+		if (m_file_size == 0 || design_list.size() < m_rows_written || m_rows_changed ||
+			flatten_dom_rels(dom_rels) != m_dom_rels) {
+			return compact(design_list, dom_rels, front_ids);
+		}
+
+		std::vector<uint64_t> ranks;
+		std::vector<uint64_t> fronts;
+		find_checkpoint_ranks(design_list, dom_rels.size(), front_ids, ranks, fronts);
+
+		const std::vector<PerfMetric> layout = find_checkpoint_layout(design_list);
+		std::vector<uint64_t> words;
+
+		// Append the new designs
+		uint64_t rows_offset = 0;
+		if (design_list.size() > m_rows_written) {
+			rows_offset = m_file_size;
+			build_rows_record(design_list, layout, m_rows_written, design_list.size(), words);
+		}
+
+		// Append the ranks and fronts which have changed since the previous call
+		const uint64_t delta_offset = m_file_size + words.size() * sizeof(uint64_t);
+		const size_t num_entries = build_delta_record(m_head_offset, rows_offset, dom_rels.size(),
+			m_ranks, m_front_ids, ranks, fronts, words);
+		if (rows_offset == 0 && num_entries == 0) {
+			return true; // Nothing to write
+		}
+
+		std::fstream file(m_filename, std::ios::in | std::ios::out | std::ios::binary);
+		if (!file.is_open()) {
+			return false;
+		}
+
+		file.seekp(m_file_size);
+		if (!write_words(file, words) || !file.flush()) {
+			return false;
+		}
+
+		// Only point the header at the new delta once it has been written in full
+		file.seekp(CHECKPOINT_HEAD_OFFSET_POS);
+		file.write(reinterpret_cast<const char*>(&delta_offset), sizeof(delta_offset));
+		if (!file.flush()) {
+			return false;
+		}
+		file.close();
+
+		m_file_size += words.size() * sizeof(uint64_t);
+		m_head_offset = delta_offset;
+		m_num_deltas++;
+		m_rows_written = design_list.size();
+		m_ranks.swap(ranks);
+		m_front_ids.swap(fronts);
+
+		if (m_num_deltas > CHECKPOINT_MAX_DELTAS) {
+			return compact(design_list, dom_rels, front_ids);
+		}
+		return true;
+	}
+
+	void CheckpointWriter::mark_changed(const size_t& idx) {
+		if (idx < m_rows_written) {
+			m_rows_changed = true;
+		}
+	}
+
+	bool CheckpointWriter::compact(const std::vector<Design>& design_list,
+		const std::vector<DomRel>& dom_rels, const std::vector<size_t>& front_ids) {
+
+		const std::vector<PerfMetric> layout = find_checkpoint_layout(design_list);
+		const std::vector<uint64_t> flat_dom_rels = flatten_dom_rels(dom_rels);
+		const uint64_t header_size = CHECKPOINT_HEADER_WORDS * sizeof(uint64_t);
+
+		std::vector<uint64_t> ranks;
+		std::vector<uint64_t> fronts;
+		find_checkpoint_ranks(design_list, dom_rels.size(), front_ids, ranks, fronts);
+
+		std::vector<uint64_t> words(CHECKPOINT_HEADER_WORDS, 0);
+		std::memcpy(&words[0], CHECKPOINT_MAGIC, sizeof(uint64_t));
+		words[1] = CHECKPOINT_VERSION;
+
+		std::vector<uint64_t> segments;
+		if (design_list.size() > 0) {
+			segments.push_back(header_size);
+			build_rows_record(design_list, layout, 0, design_list.size(), words);
+		}
+
+		const uint64_t state_offset = words.size() * sizeof(uint64_t);
+		words[2] = state_offset;
+		build_state_record(layout, flat_dom_rels, ranks, fronts, segments, words);
+
+		// Write the compacted file next to the checkpoint, then replace it
+		const std::string temp_filename = m_filename + ".tmp";
+		{
+			std::ofstream file(temp_filename, std::ios::binary | std::ios::trunc);
+			if (!file.is_open() || !write_words(file, words) || !file.flush()) {
+				return false;
+			}
+		}
+
+		std::error_code error;
+		std::filesystem::rename(temp_filename, m_filename, error);
+		if (error) {
+			return false;
+		}
+
+		m_file_size = words.size() * sizeof(uint64_t);
+		m_head_offset = state_offset;
+		m_num_deltas = 0;
+		m_rows_written = design_list.size();
+		m_rows_changed = false;
+		m_dom_rels = flat_dom_rels;
+		m_ranks.swap(ranks);
+		m_front_ids.swap(fronts);
+		return true;
+	}
+
+	/* CHECKPOINT READER FUNCTIONS*/
+
+	bool CheckpointReader::open(const std::string& filename) {
+		close();
+
+#ifdef _WIN32
+		HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE,
+			nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (file == INVALID_HANDLE_VALUE) {
+			return false;
+		}
+
+		LARGE_INTEGER file_size;
+		if (!GetFileSizeEx(file, &file_size) || file_size.QuadPart == 0) {
+			CloseHandle(file);
+			return false;
+		}
+
+		HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		CloseHandle(file);
+		if (mapping == nullptr) {
+			return false;
+		}
+
+		void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+		if (data == nullptr) {
+			CloseHandle(mapping);
+			return false;
+		}
+
+		m_handle = mapping;
+		m_data = static_cast<const unsigned char*>(data);
+		m_size = static_cast<uint64_t>(file_size.QuadPart);
+#else
+		const int fd = ::open(filename.c_str(), O_RDONLY);
+		if (fd < 0) {
+			return false;
+		}
+
+		struct stat file_stat;
+		if (fstat(fd, &file_stat) != 0 || file_stat.st_size == 0) {
+			::close(fd);
+			return false;
+		}
+
+		void* data = mmap(nullptr, file_stat.st_size, PROT_READ, MAP_SHARED, fd, 0);
+		::close(fd);
+		if (data == MAP_FAILED) {
+			return false;
+		}
+
+		m_data = static_cast<const unsigned char*>(data);
+		m_size = static_cast<uint64_t>(file_stat.st_size);
+#endif
+
+		const uint64_t num_words = m_size / sizeof(uint64_t);
+		const uint64_t* words = reinterpret_cast<const uint64_t*>(m_data);
+
+		// Check that [pos, pos + count) lies within the file
+		auto in_file = [num_words](const uint64_t& pos, const uint64_t& count) {
+			return pos <= num_words && count <= num_words - pos;
+		};
+
+		// Check the header
+		if (!in_file(0, CHECKPOINT_HEADER_WORDS) ||
+			std::memcmp(m_data, CHECKPOINT_MAGIC, sizeof(uint64_t)) != 0 ||
+			words[1] != CHECKPOINT_VERSION || words[2] % sizeof(uint64_t) != 0) {
+			close();
+			return false;
+		}
+
+		// Follow the deltas back to the latest state. Every delta points to an earlier
+		// record, so this ends.
+		m_head_offset = words[2];
+		uint64_t state_pos = words[2] / sizeof(uint64_t);
+		std::vector<uint64_t> delta_positions;
+
+		while (state_pos >= CHECKPOINT_HEADER_WORDS && in_file(state_pos, 6) &&
+			words[state_pos] == CHECKPOINT_DELTA_RECORD) {
+			const uint64_t prev_offset = words[state_pos + 2];
+			if (!in_file(state_pos + 2, words[state_pos + 1]) || words[state_pos + 1] < 4 ||
+				prev_offset % sizeof(uint64_t) != 0 || prev_offset / sizeof(uint64_t) >= state_pos) {
+				close();
+				return false;
+			}
+			delta_positions.push_back(state_pos);
+			state_pos = prev_offset / sizeof(uint64_t);
+		}
+		m_num_deltas = delta_positions.size();
+
+		// Read the fixed part of the state
+		if (state_pos < CHECKPOINT_HEADER_WORDS || !in_file(state_pos, 6) ||
+			words[state_pos] != CHECKPOINT_STATE_RECORD ||
+			!in_file(state_pos + 2, words[state_pos + 1])) {
+			close();
+			return false;
+		}
+
+		const uint64_t state_end = state_pos + 2 + words[state_pos + 1];
+		m_num_designs = words[state_pos + 2];
+		m_num_metrics = words[state_pos + 3];
+		m_num_layers = words[state_pos + 4];
+		const uint64_t num_segments = words[state_pos + 5];
+
+		// Find every array of the state
+		uint64_t pos = state_pos + 6;
+		auto take = [&](const uint64_t& count) -> const uint64_t* {
+			if (pos > state_end || count > state_end - pos) {
+				return nullptr;
+			}
+			const uint64_t* array = words + pos;
+			pos += count;
+			return array;
+		};
+
+		const uint64_t max_words = state_end - pos;
+		if (m_num_metrics > max_words || m_num_layers > max_words || num_segments > max_words ||
+			m_num_designs > max_words || (m_num_layers > 0 && m_num_designs > max_words / m_num_layers)) {
+			close();
+			return false;
+		}
+
+		m_metric_ids = take(m_num_metrics);
+		m_minimize = take(m_num_metrics);
+		m_dom_rels = take(2 * m_num_layers);
+		const uint64_t* segment_offsets = take(num_segments);
+		m_ranks = take(m_num_designs * m_num_layers);
+		m_front_ids = take(m_num_designs);
+
+		if (m_metric_ids == nullptr || m_minimize == nullptr || m_dom_rels == nullptr ||
+			segment_offsets == nullptr || m_ranks == nullptr || m_front_ids == nullptr) {
+			close();
+			return false;
+		}
+
+		for (uint64_t m = 0; m < m_num_metrics; m++) {
+			const uint64_t* name_length = take(1);
+			if (name_length == nullptr) {
+				close();
+				return false;
+			}
+
+			const uint64_t name_words = (*name_length + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+			const uint64_t* name = take(name_words);
+			if (name == nullptr) {
+				close();
+				return false;
+			}
+			m_metric_names.emplace_back(reinterpret_cast<const char*>(name), *name_length);
+		}
+
+		// Read the header of a rows record, which must hold the rows after the previous one
+		uint64_t next_row = 0;
+		auto add_segment = [&](const uint64_t& offset) {
+			const uint64_t seg_pos = offset / sizeof(uint64_t);
+			if (offset % sizeof(uint64_t) != 0 || !in_file(seg_pos, 5) ||
+				words[seg_pos] != CHECKPOINT_ROWS_RECORD || !in_file(seg_pos + 2, words[seg_pos + 1])) {
+				return false;
+			}
+
+			RowSegment segment;
+			segment.row_begin = words[seg_pos + 2];
+			segment.row_count = words[seg_pos + 3];
+
+			const uint64_t payload_words = words[seg_pos + 1];
+			if (segment.row_begin != next_row || words[seg_pos + 4] != m_num_metrics ||
+				segment.row_count > payload_words ||
+				payload_words != 3 + segment.row_count * (1 + m_num_metrics)) {
+				return false;
+			}
+
+			segment.design_ids = words + seg_pos + 5;
+			segment.values = reinterpret_cast<const double*>(words + seg_pos + 5 + segment.row_count);
+			m_segments.push_back(segment);
+
+			next_row += segment.row_count;
+			return true;
+		};
+
+		for (uint64_t s = 0; s < num_segments; s++) {
+			if (!add_segment(segment_offsets[s])) {
+				close();
+				return false;
+			}
+		}
+
+		if (next_row != m_num_designs) {
+			close();
+			return false;
+		}
+
+		// Apply the deltas from the oldest to the latest
+		const uint64_t state_designs = m_num_designs;
+		const uint64_t entry_words = m_num_layers + 2;
+
+		for (auto found = delta_positions.rbegin(); found != delta_positions.rend(); ++found) {
+			const uint64_t delta_pos = *found;
+			const uint64_t payload_words = words[delta_pos + 1];
+			const uint64_t num_designs = words[delta_pos + 3];
+			const uint64_t rows_offset = words[delta_pos + 4];
+			const uint64_t num_entries = words[delta_pos + 5];
+
+			if (num_entries > payload_words / entry_words ||
+				payload_words != 4 + num_entries * entry_words ||
+				(rows_offset != 0 && !add_segment(rows_offset)) || next_row != num_designs) {
+				close();
+				return false;
+			}
+			m_num_designs = num_designs;
+
+			const uint64_t* entry = words + delta_pos + 6;
+			for (uint64_t e = 0; e < num_entries; e++, entry += entry_words) {
+				if (entry[0] >= m_num_designs) {
+					close();
+					return false;
+				}
+				m_changed[entry[0]] = entry + 1;
+			}
+		}
+
+		// The designs added by the deltas are not in the state
+		for (uint64_t idx = state_designs; idx < m_num_designs; idx++) {
+			if (m_changed.find(idx) == m_changed.end()) {
+				close();
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	void CheckpointReader::close() {
+		if (m_data != nullptr) {
+#ifdef _WIN32
+			UnmapViewOfFile(m_data);
+			CloseHandle(static_cast<HANDLE>(m_handle));
+#else
+			munmap(const_cast<unsigned char*>(m_data), m_size);
+#endif
+		}
+
+		m_data = nullptr;
+		m_handle = nullptr;
+		m_size = 0;
+		m_head_offset = 0;
+		m_num_deltas = 0;
+		m_num_designs = 0;
+		m_num_metrics = 0;
+		m_num_layers = 0;
+		m_metric_ids = nullptr;
+		m_minimize = nullptr;
+		m_dom_rels = nullptr;
+		m_ranks = nullptr;
+		m_front_ids = nullptr;
+		m_metric_names.clear();
+		m_segments.clear();
+		m_changed.clear();
+	}
+
+	MetricID CheckpointReader::get_metric_id(const size_t& col) const {
+		return MetricID(m_metric_names[col], m_metric_ids[col]);
+	}
+
+	std::vector<DomRel> CheckpointReader::get_dom_rels() const {
+		std::vector<DomRel> dom_rels;
+		for (size_t j = 0; j < m_num_layers; j++) {
+			dom_rels.push_back(DomRel(m_dom_rels[2 * j], m_dom_rels[2 * j + 1]));
+		}
+		return dom_rels;
+	}
+
+	const CheckpointReader::RowSegment& CheckpointReader::find_segment(const size_t& idx) const {
+		// The segments are sorted by their first row
+		auto found = std::upper_bound(m_segments.begin(), m_segments.end(), idx,
+			[](const size_t& row, const RowSegment& segment) { return row < segment.row_begin; });
+		return *(found - 1);
+	}
+
+	size_t CheckpointReader::get_design_id(const size_t& idx) const {
+		const RowSegment& segment = find_segment(idx);
+		return segment.design_ids[idx - segment.row_begin];
+	}
+
+	size_t CheckpointReader::get_rank(const size_t& idx, const size_t& layer) const {
+		const auto changed = m_changed.find(idx);
+		if (changed != m_changed.end()) {
+			return changed->second[layer];
+		}
+		return m_ranks[idx * m_num_layers + layer];
+	}
+
+	size_t CheckpointReader::get_front_id(const size_t& idx) const {
+		const auto changed = m_changed.find(idx);
+		if (changed != m_changed.end()) {
+			return changed->second[m_num_layers];
+		}
+		return m_front_ids[idx];
+	}
+
+	double CheckpointReader::get_val(const size_t& idx, const size_t& col) const {
+		const RowSegment& segment = find_segment(idx);
+		return segment.values[col * segment.row_count + (idx - segment.row_begin)];
+	}
+
+	void CheckpointReader::restore_designs(std::vector<Design>& design_list) const {
+		design_list.clear();
+		design_list.reserve(m_num_designs);
+
+		std::vector<MetricID> metric_ids;
+		for (size_t m = 0; m < m_num_metrics; m++) {
+			metric_ids.push_back(get_metric_id(m));
+		}
+
+		std::vector<PerfMetric> perf_vector(m_num_metrics);
+		std::vector<size_t> ranks(m_num_layers);
+
+		for (const RowSegment& segment : m_segments) {
+			for (size_t i = 0; i < segment.row_count; i++) {
+				for (size_t m = 0; m < m_num_metrics; m++) {
+					perf_vector[m].set(metric_ids[m], segment.values[m * segment.row_count + i],
+						m_minimize[m] != 0);
+				}
+
+				const size_t idx = segment.row_begin + i;
+				for (size_t j = 0; j < m_num_layers; j++) {
+					ranks[j] = get_rank(idx, j);
+				}
+
+				Design design(perf_vector, segment.design_ids[i], 0, 0);
+				design.set_ranks(ranks);
+				design_list.push_back(design);
+			}
+		}
+	}
+}
@@ -1,6 +1,7 @@
 #include <iostream>
 #include <vector>
 #include <string>
+#include <utility>
 #include "../headers/DesignClasses.h"
 
 namespace MDR {
@@ -105,11 +106,19 @@ namespace MDR {
 		m_perf_vector.push_back(perf_metric);
 	}
 
+	void Design::add_perf_metric(PerfMetric&& perf_metric) {
+		m_perf_vector.push_back(std::move(perf_metric));
+	}
+
 	void Design::set_perf_vector(const std::vector<PerfMetric>& perf_vector) {
 		// Replace the existing metric vector with a specified performance metric vector
 		m_perf_vector = perf_vector;
 	}
 
+	void Design::set_perf_vector(std::vector<PerfMetric>&& perf_vector) {
+		m_perf_vector = std::move(perf_vector);
+	}
+
 	void Design::set_active_perf_metrics(const size_t& active_perf_id_1, const size_t&
 		active_perf_id_2) {
 		// Set the metrics which MDR will use to determine dominance relations
@@ -117,9 +126,24 @@ namespace MDR {
 		m_active_perf_id_2 = active_perf_id_2;
 	}
 
+	bool Design::set_perf_val(const size_t& metric_id, const double& perf_val) {
+		// Given a metric id number, set the value of that performance metric. This function
+		// will return true if the operation is successful.
+
+		for (size_t i = 0; i < m_perf_vector.size(); i++) {
+			if (m_perf_vector[i].get_metric_id() == metric_id) {
+				m_perf_vector[i].set_val(perf_val);
+				return true;
+			}
+		}
+		return false;
+	}
+
 	// Set the rank of the design
 	void Design::set_ranks(const std::vector<size_t>& ranks) { m_ranks = ranks; };
 
+	void Design::set_ranks(std::vector<size_t>&& ranks) { m_ranks = std::move(ranks); };
+
 	size_t Design::get_design_id() const {
 		return m_design_id;
 	}
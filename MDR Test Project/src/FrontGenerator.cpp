@@ -0,0 +1,143 @@
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+
+#include "../headers/DesignClasses.h"
+#include "../headers/MDRFunctions.h"
+#include "../headers/FrontGenerator.h"
+
+namespace MDR {
+
+	// The code in this file is of my own design.
+
+	// Value of m_dominators for the designs with no known dominating design
+	const size_t NO_DOMINATOR = SIZE_MAX;
+
+	// Intended constructor
+	FrontGenerator::FrontGenerator(const std::vector<Design>& design_list,
+		const std::vector<DomRel>& dom_rels, const size_t& max_designs) {
+		m_design_list = &design_list;
+		m_dom_rels = dom_rels;
+		m_max_designs = max_designs;
+
+		m_remaining.resize(design_list.size());
+		for (size_t i = 0; i < design_list.size(); i++) {
+			m_remaining[i] = i;
+		}
+		m_selected.assign(design_list.size(), false);
+		m_dominators.assign(design_list.size(), NO_DOMINATOR);
+	}
+
+	bool FrontGenerator::next_ids(std::vector<size_t>& front_ids) {
+		front_ids.clear();
+
+		if (m_remaining.empty() || (m_max_designs > 0 && m_num_selected >= m_max_designs)) {
+			return false;
+		}
+
+		const std::vector<Design>& design_list = *m_design_list;
+
+		if (!m_counting) {
+			// A remaining design belongs to the front if no remaining design dominates it
+			for (const size_t& i : m_remaining) {
+				// The last design found to dominate it may still be there
+				if (m_dominators[i] != NO_DOMINATOR && !m_selected[m_dominators[i]]) {
+					continue;
+				}
+
+				bool dominated = false;
+				for (const size_t& j : m_remaining) {
+					if (j != i && A_dominates_B_MDR(design_list[j], design_list[i], m_dom_rels)) {
+						m_dominators[i] = j;
+						dominated = true;
+						break;
+					}
+				}
+
+				if (!dominated) {
+					front_ids.push_back(i);
+				}
+			}
+
+			// Every remaining design is dominated (a cycle): count the dominations among the
+			// remaining designs once. From then on the counts are kept up to date as fronts
+			// are selected, as further cycles are likely.
+			if (front_ids.empty()) {
+				m_dominations.assign(design_list.size(), 0);
+				for (const size_t& i : m_remaining) {
+					for (const size_t& j : m_remaining) {
+						if (j != i && A_dominates_B_MDR(design_list[j], design_list[i], m_dom_rels)) {
+							m_dominations[i] += 1;
+						}
+					}
+				}
+				m_counting = true;
+			}
+		}
+
+		// The front is made of the designs dominated the minimum number of times (not at all
+		// unless there is a cycle), as in find_pareto_front
+		if (m_counting) {
+			size_t mindom = SIZE_MAX;
+			for (const size_t& i : m_remaining) {
+				mindom = std::min(mindom, m_dominations[i]);
+			}
+			for (const size_t& i : m_remaining) {
+				if (m_dominations[i] == mindom) {
+					front_ids.push_back(i);
+				}
+			}
+		}
+
+		for (const size_t& i : front_ids) {
+			m_selected[i] = true;
+		}
+		m_remaining.erase(std::remove_if(m_remaining.begin(), m_remaining.end(),
+			[this](const size_t& i) { return m_selected[i]; }), m_remaining.end());
+
+		// Take the dominations by the selected designs out of the counts, in O(r |front|)
+		if (m_counting) {
+			for (const size_t& i : m_remaining) {
+				for (const size_t& j : front_ids) {
+					if (A_dominates_B_MDR(design_list[j], design_list[i], m_dom_rels)) {
+						m_dominations[i] -= 1;
+					}
+				}
+			}
+		}
+
+		m_num_selected += front_ids.size();
+		m_num_fronts += 1;
+		return true;
+	}
+
+	bool FrontGenerator::next(std::vector<Design>& front) {
+		front.clear();
+
+		std::vector<size_t> front_ids;
+		if (!next_ids(front_ids)) {
+			return false;
+		}
+
+		front.reserve(front_ids.size());
+		for (const size_t& i : front_ids) {
+			front.push_back((*m_design_list)[i]);
+		}
+		return true;
+	}
+
+	// Return the first fronts of a list of designs according to MDR
+	std::vector<std::vector<Design>> find_first_fronts(const std::vector<Design>& design_list,
+		const std::vector<DomRel>& dom_rels, const size_t& num_fronts, const size_t& max_designs) {
+
+		std::vector<std::vector<Design>> fronts;
+		FrontGenerator generator(design_list, dom_rels, max_designs);
+
+		std::vector<Design> front;
+		while (fronts.size() < num_fronts && generator.next(front)) {
+			fronts.push_back(front);
+		}
+
+		return fronts;
+	}
+}
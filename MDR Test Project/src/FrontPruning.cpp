@@ -0,0 +1,583 @@
+#include <vector>
+#include <array>
+#include <queue>
+#include <limits>
+#include <algorithm>
+#include <functional>
+#include <cmath>
+
+#include "../headers/DesignClasses.h"
+#include "../headers/FrontPruning.h"
+
+namespace MDR {
+
+	// The code in this file is of my own design, unless otherwise stated.
+
+	const size_t NO_NEIGHBOUR = std::numeric_limits<size_t>::max();
+	const double INFINITE_DISTANCE = std::numeric_limits<double>::infinity();
+
+	// Fraction of the range of a metric between its worst value and a found reference point
+	const double REFERENCE_MARGIN = 0.1;
+
+	// A design waiting to be removed, ordered by its score and then by its index
+	typedef std::pair<double, size_t> RemovalCandidate;
+	typedef std::priority_queue<RemovalCandidate, std::vector<RemovalCandidate>,
+		std::greater<RemovalCandidate>> RemovalQueue;
+
+	// Store the direction corrected values of a metric for every design of a front
+	void get_corrected_values(const std::vector<Design>& front, const size_t& metric_id,
+		std::vector<double>& values) {
+
+		values.assign(front.size(), 0);
+		for (size_t i = 0; i < front.size(); i++) {
+			double val = 0;
+			bool minimize = true;
+			front[i].get_perf_val(metric_id, val);
+			front[i].get_perf_minimize(metric_id, minimize);
+			values[i] = minimize ? val : -val;
+		}
+	}
+
+	// Return the direction corrected version of a reference value for a metric of a front
+	double get_corrected_ref(const std::vector<Design>& front, const size_t& metric_id,
+		const double& ref) {
+
+		bool minimize = true;
+		if (front.size() > 0) {
+			front[0].get_perf_minimize(metric_id, minimize);
+		}
+		return minimize ? ref : -ref;
+	}
+
+	// Return the unique metric ids of a list of dominance relations
+	std::vector<size_t> get_dom_rel_metric_ids(const std::vector<DomRel>& dom_rels) {
+		std::vector<size_t> metric_ids;
+		for (const DomRel& dom_rel : dom_rels) {
+			for (int k = 0; k < 2; k++) {
+				if (std::find(metric_ids.begin(), metric_ids.end(), dom_rel[k]) == metric_ids.end()) {
+					metric_ids.push_back(dom_rel[k]);
+				}
+			}
+		}
+		return metric_ids;
+	}
+
+	// Return the designs of a front which have not been removed, in their original order
+	std::vector<Design> collect_kept_designs(const std::vector<Design>& front,
+		const std::vector<bool>& removed) {
+
+		std::vector<Design> kept;
+		for (size_t i = 0; i < front.size(); i++) {
+			if (!removed[i]) {
+				kept.push_back(front[i]);
+			}
+		}
+		return kept;
+	}
+
+	// Compute the crowding distance of every design of a front over a list of metrics
+	void crowding_distances(const std::vector<Design>& front, const std::vector<size_t>& metric_ids,
+		std::vector<double>& distances) {
+
+		const size_t n = front.size();
+		distances.assign(n, 0);
+
+		std::vector<std::vector<double>> values(metric_ids.size());
+		std::vector<bool> valid(n, true);
+		for (size_t m = 0; m < metric_ids.size(); m++) {
+			get_corrected_values(front, metric_ids[m], values[m]);
+			for (size_t i = 0; i < n; i++) {
+				valid[i] = valid[i] && !std::isnan(values[m][i]);
+			}
+		}
+
+		std::vector<size_t> order;
+		for (size_t m = 0; m < metric_ids.size(); m++) {
+			const std::vector<double>& vals = values[m];
+
+			order.clear();
+			for (size_t i = 0; i < n; i++) {
+				if (valid[i]) {
+					order.push_back(i);
+				}
+			}
+			if (order.size() < 1) {
+				return;
+			}
+
+			std::sort(order.begin(), order.end(),
+				[&vals](const size_t& a, const size_t& b) { return vals[a] < vals[b]; });
+
+			distances[order.front()] = INFINITE_DISTANCE;
+			distances[order.back()] = INFINITE_DISTANCE;
+
+			const double range = vals[order.back()] - vals[order.front()];
+			if (!(range > 0) || !std::isfinite(range)) {
+				continue;
+			}
+
+			for (size_t j = 1; j + 1 < order.size(); j++) {
+				distances[order[j]] += (vals[order[j + 1]] - vals[order[j - 1]]) / range;
+			}
+		}
+	}
+
+	// Return the area dominated by a front in the metrics of a dominance relation
+	double hypervolume_2D(const std::vector<Design>& front, const DomRel& dom_rel,
+		const std::array<double, 2>& ref_point) {
+
+		std::vector<double> xs;
+		std::vector<double> ys;
+		get_corrected_values(front, dom_rel[0], xs);
+		get_corrected_values(front, dom_rel[1], ys);
+		const double ref_x = get_corrected_ref(front, dom_rel[0], ref_point[0]);
+		const double ref_y = get_corrected_ref(front, dom_rel[1], ref_point[1]);
+
+		// Only the designs strictly inside the reference box dominate any area (this also
+		// leaves out NaNs)
+		std::vector<size_t> order;
+		for (size_t i = 0; i < front.size(); i++) {
+			if (xs[i] < ref_x && ys[i] < ref_y) {
+				order.push_back(i);
+			}
+		}
+
+		std::sort(order.begin(), order.end(), [&](const size_t& a, const size_t& b) {
+			return xs[a] < xs[b] || (xs[a] == xs[b] && ys[a] < ys[b]);
+		});
+
+		// Sweep along the first metric, adding the strip each design adds below the others
+		double area = 0;
+		double current_y = ref_y;
+		for (const size_t& i : order) {
+			if (ys[i] < current_y) {
+				area += (ref_x - xs[i]) * (current_y - ys[i]);
+				current_y = ys[i];
+			}
+		}
+		return area;
+	}
+
+	// For every design in ids, find the smallest "second" value among the other designs of ids
+	// whose "first" value is not larger. Please note that the output (min_others) is an
+	// argument of this function.
+	void find_min_of_others(const std::vector<size_t>& ids, const std::vector<double>& first,
+		const std::vector<double>& second, std::vector<double>& min_others) {
+
+		std::vector<size_t> order = ids;
+		std::sort(order.begin(), order.end(), [&](const size_t& a, const size_t& b) {
+			return first[a] < first[b] || (first[a] == first[b] && second[a] < second[b]);
+		});
+
+		double prefix_min = INFINITE_DISTANCE; // Over the groups with a smaller first value
+
+		size_t group_begin = 0;
+		while (group_begin < order.size()) {
+			size_t group_end = group_begin;
+			while (group_end < order.size() && first[order[group_end]] == first[order[group_begin]]) {
+				group_end++;
+			}
+
+			// The group is sorted by its second value
+			const double group_smallest = second[order[group_begin]];
+			const double group_second_smallest = group_end - group_begin > 1 ?
+				second[order[group_begin + 1]] : INFINITE_DISTANCE;
+
+			for (size_t j = group_begin; j < group_end; j++) {
+				const double in_group = j == group_begin ? group_second_smallest : group_smallest;
+				min_others[order[j]] = std::min(prefix_min, in_group);
+			}
+
+			prefix_min = std::min(prefix_min, group_smallest);
+			group_begin = group_end;
+		}
+	}
+
+	// Compute the hypervolume contribution of every design of a front
+	void hypervolume_contributions_2D(const std::vector<Design>& front, const DomRel& dom_rel,
+		const std::array<double, 2>& ref_point, std::vector<double>& contributions) {
+
+		const size_t n = front.size();
+		contributions.assign(n, 0);
+
+		std::vector<double> xs;
+		std::vector<double> ys;
+		get_corrected_values(front, dom_rel[0], xs);
+		get_corrected_values(front, dom_rel[1], ys);
+		const double ref_x = get_corrected_ref(front, dom_rel[0], ref_point[0]);
+		const double ref_y = get_corrected_ref(front, dom_rel[1], ref_point[1]);
+
+		std::vector<size_t> order;
+		for (size_t i = 0; i < n; i++) {
+			if (xs[i] < ref_x && ys[i] < ref_y) {
+				order.push_back(i);
+			}
+		}
+		std::sort(order.begin(), order.end(), [&](const size_t& a, const size_t& b) {
+			return xs[a] < xs[b] || (xs[a] == xs[b] && ys[a] < ys[b]);
+		});
+
+		// Leave out the designs strictly dominated by another one (A_dominates_B_2D)
+		std::vector<size_t> kept;
+		double best_earlier = INFINITE_DISTANCE; // Best y among strictly smaller x
+		size_t group_begin = 0;
+		while (group_begin < order.size()) {
+			size_t group_end = group_begin;
+			while (group_end < order.size() && xs[order[group_end]] == xs[order[group_begin]]) {
+				if (!(best_earlier < ys[order[group_end]])) {
+					kept.push_back(order[group_end]);
+				}
+				group_end++;
+			}
+			best_earlier = std::min(best_earlier, ys[order[group_begin]]);
+			group_begin = group_end;
+		}
+
+		// The area dominated by a design only is bounded above by the lowest design on its
+		// left (upper_y) and on the right by the leftmost design below it (right_x)
+		std::vector<double> upper_y(n, INFINITE_DISTANCE);
+		std::vector<double> right_x(n, INFINITE_DISTANCE);
+		find_min_of_others(kept, xs, ys, upper_y);
+		find_min_of_others(kept, ys, xs, right_x);
+
+		for (const size_t& i : kept) {
+			const double width = std::min(ref_x, right_x[i]) - xs[i];
+			const double height = std::min(ref_y, upper_y[i]) - ys[i];
+			contributions[i] = std::max(0.0, width) * std::max(0.0, height);
+		}
+	}
+
+	// Reduce a front to target_size designs by crowding distance
+	std::vector<Design> truncate_front_crowding(const std::vector<Design>& front,
+		const std::vector<DomRel>& dom_rels, const size_t& target_size) {
+
+		const size_t n = front.size();
+		if (target_size >= n) {
+			return front;
+		}
+
+		const std::vector<size_t> metric_ids = get_dom_rel_metric_ids(dom_rels);
+		const size_t num_metrics = metric_ids.size();
+
+		std::vector<std::vector<double>> values(num_metrics);
+		std::vector<bool> valid(n, true);
+		for (size_t m = 0; m < num_metrics; m++) {
+			get_corrected_values(front, metric_ids[m], values[m]);
+			for (size_t i = 0; i < n; i++) {
+				valid[i] = valid[i] && !std::isnan(values[m][i]);
+			}
+		}
+
+		std::vector<bool> removed(n, false);
+		size_t num_kept = n;
+
+		// Designs holding a NaN are removed first
+		for (size_t i = 0; i < n && num_kept > target_size; i++) {
+			if (!valid[i]) {
+				removed[i] = true;
+				num_kept--;
+			}
+		}
+
+		// Link the remaining designs in the order of each metric
+		std::vector<std::vector<size_t>> prev(num_metrics, std::vector<size_t>(n, NO_NEIGHBOUR));
+		std::vector<std::vector<size_t>> next(num_metrics, std::vector<size_t>(n, NO_NEIGHBOUR));
+		std::vector<double> ranges(num_metrics, 0);
+		std::vector<size_t> order;
+
+		for (size_t m = 0; m < num_metrics; m++) {
+			const std::vector<double>& vals = values[m];
+
+			order.clear();
+			for (size_t i = 0; i < n; i++) {
+				if (!removed[i] && valid[i]) {
+					order.push_back(i);
+				}
+			}
+			std::sort(order.begin(), order.end(),
+				[&vals](const size_t& a, const size_t& b) { return vals[a] < vals[b]; });
+
+			for (size_t j = 0; j + 1 < order.size(); j++) {
+				next[m][order[j]] = order[j + 1];
+				prev[m][order[j + 1]] = order[j];
+			}
+			if (order.size() > 0) {
+				ranges[m] = vals[order.back()] - vals[order.front()];
+			}
+		}
+
+		// The ranges are kept from the full front, so distances stay comparable
+		auto distance = [&](const size_t& i) {
+			double dist = 0;
+			for (size_t m = 0; m < num_metrics; m++) {
+				if (prev[m][i] == NO_NEIGHBOUR || next[m][i] == NO_NEIGHBOUR) {
+					return INFINITE_DISTANCE;
+				}
+				if (ranges[m] > 0 && std::isfinite(ranges[m])) {
+					dist += (values[m][next[m][i]] - values[m][prev[m][i]]) / ranges[m];
+				}
+			}
+			return dist;
+		};
+
+		std::vector<double> current(n, 0);
+		RemovalQueue queue;
+		for (size_t i = 0; i < n; i++) {
+			if (!removed[i]) {
+				current[i] = distance(i);
+				queue.push({ current[i], i });
+			}
+		}
+
+		// Repeatedly remove the most crowded design, updating only its neighbours
+		while (num_kept > target_size && queue.size() > 0) {
+			const RemovalCandidate candidate = queue.top();
+			queue.pop();
+
+			const size_t i = candidate.second;
+			if (removed[i] || candidate.first != current[i]) {
+				continue; // Out of date entry
+			}
+
+			removed[i] = true;
+			num_kept--;
+
+			std::vector<size_t> neighbours;
+			for (size_t m = 0; m < num_metrics; m++) {
+				const size_t before = prev[m][i];
+				const size_t after = next[m][i];
+				if (before != NO_NEIGHBOUR) {
+					next[m][before] = after;
+					neighbours.push_back(before);
+				}
+				if (after != NO_NEIGHBOUR) {
+					prev[m][after] = before;
+					neighbours.push_back(after);
+				}
+			}
+
+			for (const size_t& j : neighbours) {
+				const double updated = distance(j);
+				if (updated != current[j]) {
+					current[j] = updated;
+					queue.push({ updated, j });
+				}
+			}
+		}
+
+		return collect_kept_designs(front, removed);
+	}
+
+	// Find a direction corrected reference point beyond the worst finite values of a list of
+	// designs (given by their index). Please note that the outputs (ref_x and ref_y) are
+	// arguments of this function.
+	bool find_corrected_reference(const std::vector<size_t>& ids, const std::vector<double>& xs,
+		const std::vector<double>& ys, double& ref_x, double& ref_y) {
+
+		bool found = false;
+		double best_x = 0;
+		double worst_x = 0;
+		double best_y = 0;
+		double worst_y = 0;
+		for (const size_t& i : ids) {
+			if (!std::isfinite(xs[i]) || !std::isfinite(ys[i])) {
+				continue;
+			}
+			best_x = found ? std::min(best_x, xs[i]) : xs[i];
+			worst_x = found ? std::max(worst_x, xs[i]) : xs[i];
+			best_y = found ? std::min(best_y, ys[i]) : ys[i];
+			worst_y = found ? std::max(worst_y, ys[i]) : ys[i];
+			found = true;
+		}
+		if (!found) {
+			return false;
+		}
+
+		const double range_x = worst_x - best_x;
+		const double range_y = worst_y - best_y;
+		ref_x = worst_x + (range_x > 0 ? REFERENCE_MARGIN * range_x : 1);
+		ref_y = worst_y + (range_y > 0 ? REFERENCE_MARGIN * range_y : 1);
+		return true;
+	}
+
+	// Find a reference point for the metrics of a dominance relation
+	bool find_reference_point(const std::vector<Design>& front, const DomRel& dom_rel,
+		std::array<double, 2>& ref_point) {
+
+		std::vector<double> xs;
+		std::vector<double> ys;
+		get_corrected_values(front, dom_rel[0], xs);
+		get_corrected_values(front, dom_rel[1], ys);
+
+		std::vector<size_t> ids(front.size());
+		for (size_t i = 0; i < front.size(); i++) {
+			ids[i] = i;
+		}
+
+		double ref_x = 0;
+		double ref_y = 0;
+		if (!find_corrected_reference(ids, xs, ys, ref_x, ref_y)) {
+			return false;
+		}
+
+		// Back to the orientation of the metrics
+		ref_point[0] = get_corrected_ref(front, dom_rel[0], ref_x);
+		ref_point[1] = get_corrected_ref(front, dom_rel[1], ref_y);
+		return true;
+	}
+
+	// Remove the designs of a list (given by their index, all strictly inside the reference
+	// box) by hypervolume contribution, until num_kept reaches target_size
+	void remove_by_contribution(const std::vector<size_t>& ids, const std::vector<double>& xs,
+		const std::vector<double>& ys, const double& ref_x, const double& ref_y,
+		const size_t& target_size, size_t& num_kept, std::vector<bool>& removed) {
+
+		// Split the designs into a staircase (x strictly increasing, y strictly decreasing)
+		// and the designs which are dominated by, or equal to, a staircase design
+		std::vector<size_t> order = ids;
+		std::sort(order.begin(), order.end(), [&](const size_t& a, const size_t& b) {
+			return xs[a] < xs[b] || (xs[a] == xs[b] && ys[a] < ys[b]);
+		});
+
+		std::vector<size_t> staircase;
+		for (const size_t& i : order) {
+			if (staircase.size() < 1 || ys[i] < ys[staircase.back()]) {
+				staircase.push_back(i);
+			}
+			else if (num_kept > target_size && !removed[i]) {
+				// Contributes nothing as long as the staircase design is kept
+				removed[i] = true;
+				num_kept--;
+			}
+		}
+
+		// Link the staircase designs. Each one's contribution is the rectangle between its
+		// neighbours (or the reference point).
+		const size_t num_steps = staircase.size();
+		std::vector<size_t> prev(num_steps, NO_NEIGHBOUR);
+		std::vector<size_t> next(num_steps, NO_NEIGHBOUR);
+		for (size_t s = 0; s + 1 < num_steps; s++) {
+			next[s] = s + 1;
+			prev[s + 1] = s;
+		}
+
+		auto contribution = [&](const size_t& s) {
+			const size_t i = staircase[s];
+			const double right = next[s] == NO_NEIGHBOUR ? ref_x : xs[staircase[next[s]]];
+			const double top = prev[s] == NO_NEIGHBOUR ? ref_y : ys[staircase[prev[s]]];
+			return (right - xs[i]) * (top - ys[i]);
+		};
+
+		std::vector<bool> step_removed(num_steps, false);
+		std::vector<double> current(num_steps, 0);
+		RemovalQueue queue;
+		for (size_t s = 0; s < num_steps; s++) {
+			current[s] = contribution(s);
+			queue.push({ current[s], s });
+		}
+
+		// Repeatedly remove the smallest contributor, updating only its neighbours
+		while (num_kept > target_size && queue.size() > 0) {
+			const RemovalCandidate candidate = queue.top();
+			queue.pop();
+
+			const size_t s = candidate.second;
+			if (step_removed[s] || candidate.first != current[s]) {
+				continue; // Out of date entry
+			}
+
+			step_removed[s] = true;
+			removed[staircase[s]] = true;
+			num_kept--;
+
+			if (prev[s] != NO_NEIGHBOUR) {
+				next[prev[s]] = next[s];
+			}
+			if (next[s] != NO_NEIGHBOUR) {
+				prev[next[s]] = prev[s];
+			}
+
+			for (const size_t& neighbour : { prev[s], next[s] }) {
+				if (neighbour != NO_NEIGHBOUR) {
+					current[neighbour] = contribution(neighbour);
+					queue.push({ current[neighbour], neighbour });
+				}
+			}
+		}
+	}
+
+	// Reduce a front to target_size designs by hypervolume contribution
+	std::vector<Design> truncate_front_hypervolume(const std::vector<Design>& front,
+		const DomRel& dom_rel, const std::array<double, 2>& ref_point, const size_t& target_size) {
+
+		const size_t n = front.size();
+		if (target_size >= n) {
+			return front;
+		}
+
+		std::vector<double> xs;
+		std::vector<double> ys;
+		get_corrected_values(front, dom_rel[0], xs);
+		get_corrected_values(front, dom_rel[1], ys);
+		const double ref_x = get_corrected_ref(front, dom_rel[0], ref_point[0]);
+		const double ref_y = get_corrected_ref(front, dom_rel[1], ref_point[1]);
+
+		std::vector<bool> removed(n, false);
+		size_t num_kept = n;
+
+		std::vector<size_t> inside;
+		std::vector<size_t> outside;
+		for (size_t i = 0; i < n; i++) {
+			if (xs[i] < ref_x && ys[i] < ref_y) {
+				inside.push_back(i);
+			}
+			else {
+				outside.push_back(i);
+			}
+		}
+
+		// Designs outside the reference box contribute nothing, so they are removed first.
+		// If that leaves too few designs, the inside ones are all kept and the others are
+		// chosen among the outside ones, against a reference point which holds them.
+		std::vector<size_t> fallback;
+		double fallback_ref_x = 0;
+		double fallback_ref_y = 0;
+		if (inside.size() < target_size &&
+			find_corrected_reference(outside, xs, ys, fallback_ref_x, fallback_ref_y)) {
+			for (const size_t& i : outside) {
+				if (xs[i] < fallback_ref_x && ys[i] < fallback_ref_y) {
+					fallback.push_back(i);
+				}
+			}
+		}
+
+		// Designs holding a NaN (or outside both boxes) are removed first
+		std::vector<bool> in_fallback(n, false);
+		for (const size_t& i : fallback) {
+			in_fallback[i] = true;
+		}
+		for (const size_t& i : outside) {
+			if (num_kept > target_size && !in_fallback[i]) {
+				removed[i] = true;
+				num_kept--;
+			}
+		}
+
+		remove_by_contribution(fallback, xs, ys, fallback_ref_x, fallback_ref_y, target_size,
+			num_kept, removed);
+		remove_by_contribution(inside, xs, ys, ref_x, ref_y, target_size, num_kept, removed);
+
+		return collect_kept_designs(front, removed);
+	}
+
+	// Reduce a front to target_size designs
+	std::vector<Design> truncate_front(const std::vector<Design>& front,
+		const std::vector<DomRel>& dom_rels, const size_t& target_size,
+		const TruncationMethod& method, const std::array<double, 2>& ref_point) {
+
+		if (method == TruncationMethod::Hypervolume && dom_rels.size() > 0) {
+			return truncate_front_hypervolume(front, dom_rels[0], ref_point, target_size);
+		}
+		return truncate_front_crowding(front, dom_rels, target_size);
+	}
+}
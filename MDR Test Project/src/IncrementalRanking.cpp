@@ -0,0 +1,251 @@
+#include <vector>
+#include <set>
+#include <algorithm>
+#include <assert.h>
+
+#include "../headers/DesignClasses.h"
+#include "../headers/MDRFunctions.h"
+#include "../headers/RadixFront.h"
+#include "../headers/IncrementalRanking.h"
+
+namespace MDR {
+
+	// The code in this file is of my own design.
+
+	// Intended constructor
+	IncrementalRanking::IncrementalRanking(const std::vector<Design>& design_list,
+		const std::vector<DomRel>& dom_rels) {
+		m_dom_rels = dom_rels;
+		m_fronts.resize(dom_rels.size());
+
+		// Find the metrics involved in the dominance relations
+		for (const DomRel& dom_rel : dom_rels) {
+			for (int k = 0; k < 2; k++) {
+				const auto known = std::find(m_metric_ids.begin(), m_metric_ids.end(), dom_rel[k]);
+				if (known == m_metric_ids.end()) {
+					m_metric_ids.push_back(dom_rel[k]);
+				}
+			}
+		}
+		m_sorted.resize(m_metric_ids.size());
+
+		m_designs.reserve(design_list.size());
+		for (const Design& design : design_list) {
+			add_design(design);
+		}
+	}
+
+	void IncrementalRanking::find_relations(const size_t& first, const size_t& second,
+		std::vector<unsigned char>& relations) const {
+
+		for (size_t j = 0; j < m_dom_rels.size(); j++) {
+			const DomRel& dom_rel = m_dom_rels[j];
+
+			if (A_dominates_B_2D(m_designs[first], m_designs[second], dom_rel[0], dom_rel[1])) {
+				relations.push_back(1);
+			}
+			else if (A_dominates_B_2D(m_designs[second], m_designs[first], dom_rel[0], dom_rel[1])) {
+				relations.push_back(2);
+			}
+			else {
+				relations.push_back(0);
+			}
+		}
+	}
+
+	void IncrementalRanking::update_relations(const size_t& first, const size_t& second,
+		const unsigned char* old_relations, const unsigned char* new_relations) {
+
+		// Designs dominated according to MDR (the first layer in which one design dominates
+		// decides), or nullptr if neither design dominates
+		const size_t* old_dominated = nullptr;
+		const size_t* new_dominated = nullptr;
+
+		for (size_t j = 0; j < m_dom_rels.size(); j++) {
+			if (old_dominated == nullptr && old_relations[j] != 0) {
+				old_dominated = old_relations[j] == 1 ? &second : &first;
+			}
+			if (new_dominated == nullptr && new_relations[j] != 0) {
+				new_dominated = new_relations[j] == 1 ? &second : &first;
+			}
+
+			if (old_relations[j] == new_relations[j]) {
+				continue;
+			}
+			if (old_relations[j] != 0) {
+				decrease_rank(old_relations[j] == 1 ? second : first, j);
+			}
+			if (new_relations[j] != 0) {
+				increase_rank(new_relations[j] == 1 ? second : first, j);
+			}
+		}
+
+		if (old_dominated != new_dominated) {
+			if (old_dominated != nullptr) {
+				m_dominations[*old_dominated] -= 1;
+				mark_dirty(*old_dominated);
+			}
+			if (new_dominated != nullptr) {
+				m_dominations[*new_dominated] += 1;
+				mark_dirty(*new_dominated);
+			}
+		}
+	}
+
+	void IncrementalRanking::increase_rank(const size_t& idx, const size_t& layer) {
+		if (m_designs[idx].get_ranks_view()[layer] == 0) {
+			m_fronts[layer].erase(idx);
+		}
+		m_designs[idx].increase_rank_val(layer);
+		mark_dirty(idx);
+	}
+
+	void IncrementalRanking::decrease_rank(const size_t& idx, const size_t& layer) {
+		m_designs[idx].decrease_rank_val(layer);
+		if (m_designs[idx].get_ranks_view()[layer] == 0) {
+			m_fronts[layer].insert(idx);
+		}
+		mark_dirty(idx);
+	}
+
+	void IncrementalRanking::mark_dirty(const size_t& idx) {
+		if (!m_dirty[idx]) {
+			m_dirty[idx] = true;
+			m_dirty_designs.push_back(idx);
+		}
+	}
+
+	size_t IncrementalRanking::add_design(const Design& design) {
+		const size_t idx = m_designs.size();
+
+		m_designs.push_back(design);
+		m_designs[idx].set_ranks(std::vector<size_t>(m_dom_rels.size(), 0));
+		m_dominations.push_back(0);
+		m_dirty.push_back(false);
+		mark_dirty(idx);
+
+		for (size_t k = 0; k < m_metric_ids.size(); k++) {
+			double val = 0;
+			bool minimize = true;
+			const bool found = design.get_perf_val(m_metric_ids[k], val) &&
+				design.get_perf_minimize(m_metric_ids[k], minimize);
+			assert(found); // Check OK ID
+			(void)found;
+
+			m_sorted[k].emplace(encode_metric_key(val, minimize), idx);
+		}
+
+		for (size_t j = 0; j < m_dom_rels.size(); j++) {
+			m_fronts[j].insert(idx);
+		}
+
+		// Check the new design against every existing design (Algorithm 2 from L. W. Cook et. al.)
+		const std::vector<unsigned char> no_relations(m_dom_rels.size(), 0);
+		std::vector<unsigned char> relations;
+		for (size_t i = 0; i < idx; i++) {
+			relations.clear();
+			find_relations(i, idx, relations);
+			update_relations(i, idx, no_relations.data(), relations.data());
+		}
+		m_num_checked = idx;
+
+		return idx;
+	}
+
+	bool IncrementalRanking::set_perf_val(const size_t& idx, const size_t& metric_id,
+		const double& perf_val) {
+		assert(idx < m_designs.size()); // Check OK index
+
+		m_num_checked = 0;
+
+		double old_val = 0;
+		bool minimize = true;
+		if (!m_designs[idx].get_perf_val(metric_id, old_val) ||
+			!m_designs[idx].get_perf_minimize(metric_id, minimize)) {
+			return false;
+		}
+
+		// Metrics which are not part of a dominance relation do not change any rank
+		const auto metric_pos = std::find(m_metric_ids.begin(), m_metric_ids.end(), metric_id);
+		if (metric_pos == m_metric_ids.end()) {
+			return m_designs[idx].set_perf_val(metric_id, perf_val);
+		}
+		std::set<std::pair<uint64_t, size_t>>& sorted = m_sorted[metric_pos - m_metric_ids.begin()];
+
+		const uint64_t old_key = encode_metric_key(old_val, minimize);
+		const uint64_t new_key = encode_metric_key(perf_val, minimize);
+		if (old_key == new_key) {
+			// Every comparison gives the same result (e.g. -0 replaced by +0)
+			return m_designs[idx].set_perf_val(metric_id, perf_val);
+		}
+
+		// Find the designs whose comparison with this design may change
+		std::vector<size_t> candidates;
+		if (old_key == NAN_METRIC_KEY || new_key == NAN_METRIC_KEY) {
+			for (size_t i = 0; i < m_designs.size(); i++) {
+				if (i != idx) {
+					candidates.push_back(i);
+				}
+			}
+		}
+		else {
+			const uint64_t low_key = std::min(old_key, new_key);
+			const uint64_t high_key = std::max(old_key, new_key);
+			for (auto it = sorted.lower_bound({ low_key, 0 });
+				it != sorted.end() && it->first <= high_key; ++it) {
+				if (it->second != idx) {
+					candidates.push_back(it->second);
+				}
+			}
+		}
+		m_num_checked = candidates.size();
+
+		const size_t num_layers = m_dom_rels.size();
+		std::vector<unsigned char> old_relations;
+		old_relations.reserve(candidates.size() * num_layers);
+		for (const size_t& other : candidates) {
+			find_relations(idx, other, old_relations);
+		}
+
+		m_designs[idx].set_perf_val(metric_id, perf_val);
+		sorted.erase({ old_key, idx });
+		sorted.emplace(new_key, idx);
+
+		// Only update the ranks of the pairs whose relation has changed
+		std::vector<unsigned char> new_relations;
+		for (size_t c = 0; c < candidates.size(); c++) {
+			new_relations.clear();
+			find_relations(idx, candidates[c], new_relations);
+			update_relations(idx, candidates[c], &old_relations[c * num_layers], new_relations.data());
+		}
+
+		return true;
+	}
+
+	std::vector<size_t> IncrementalRanking::get_front(const size_t& layer) const {
+		assert(layer < m_fronts.size()); // Check OK layer
+		return std::vector<size_t>(m_fronts[layer].begin(), m_fronts[layer].end());
+	}
+
+	std::vector<size_t> IncrementalRanking::get_mdr_front() const {
+		std::vector<size_t> front;
+		if (m_dominations.size() < 1) {
+			return front;
+		}
+
+		const size_t mindom = *std::min_element(m_dominations.begin(), m_dominations.end());
+		for (size_t i = 0; i < m_dominations.size(); i++) {
+			if (m_dominations[i] == mindom) {
+				front.push_back(i);
+			}
+		}
+		return front;
+	}
+
+	void IncrementalRanking::clear_dirty() {
+		for (const size_t& idx : m_dirty_designs) {
+			m_dirty[idx] = false;
+		}
+		m_dirty_designs.clear();
+	}
+}
@@ -2,70 +2,78 @@
 //
 
 #include <iostream>
-#include <fstream>
 #include <string>
+#include <cstring>
+#include <charconv>
 #include "../headers/DesignClasses.h"
 #include "../headers/MDRFunctions.h"
 #include "../headers/ReadDesigns.h"
+#include "../headers/ResultWriters.h"
+#include "../headers/RankingServer.h"
 
-int main()
+int main(int argc, char* argv[])
 {
 
-	// DEPRECATED TEST, DO NOT USE
-
 	std::vector<MDR::MetricID> metric_ids;
 	std::vector<MDR::Design> designs;
-	std::vector<MDR::Design> designs2;
 
 	read_design_file(designs, metric_ids);
-	designs2 = designs;
 
 	std::cout << "Number of candidate designs: " << designs.size() << std::endl;
 
-	std::vector<size_t> first_order = { 0,2 };
-
-	auto pareto_one = MDR::optimize_designs(designs, first_order);
-
-	std::cout << "Number of designs in pareto front (#1): " << designs.size() << std::endl;
-
-	// Create and open a text file
-	std::ofstream MyFile("pareto1.csv");
+	// Server mode: "--serve <socket path> [<metric id 1> <metric id 2>]..." keeps the designs
+	// in memory and answers ranking queries (see RankingServer.h)
+	if (argc >= 3 && std::string(argv[1]) == "--serve") {
+		std::vector<size_t> ids;
+		for (int i = 3; i < argc; i++) {
+			const char* end = argv[i] + std::strlen(argv[i]);
+			size_t id = 0;
+			const std::from_chars_result result = std::from_chars(argv[i], end, id);
+			if (result.ec != std::errc() || result.ptr != end) {
+				ids.clear();
+				break;
+			}
+			ids.push_back(id);
+		}
+		if (ids.size() % 2 != 0 || ids.size() < size_t(argc - 3)) {
+			std::cout << "Usage: " << argv[0]
+				<< " --serve <socket path> [<metric id 1> <metric id 2>]..." << std::endl;
+			return 1;
+		}
 
-	if (designs.size() > 0) {
-		for (size_t i = 0; i < designs.size() - 1; i++) {
-			std::cout << designs[i].get_design_id() << ",";
-			MyFile << std::to_string(designs[i].get_design_id()) << ",";
+		std::vector<MDR::DomRel> dom_rels;
+		for (size_t i = 0; i < ids.size(); i += 2) {
+			dom_rels.push_back(MDR::DomRel(ids[i], ids[i + 1]));
+		}
+		if (dom_rels.size() < 1) {
+			dom_rels = { MDR::DomRel(0, 2), MDR::DomRel(1, 3) };
 		}
-		std::cout << designs[designs.size() - 1].get_design_id() << std::endl;
-		MyFile << std::to_string(designs[designs.size() - 1].get_design_id());
+
+		MDR::RankingServer server(designs, dom_rels);
+		return server.run(argv[2]) ? 0 : 1;
 	}
 
-	// Close the file
-	MyFile.close();
+	std::vector<MDR::DomRel> first_order = { MDR::DomRel(0, 2) };
 
-	// Perform the 2nd pareto front
-	std::vector<size_t> second_order = { 1,3 };
+	auto pareto_one = MDR::optimize_designs(designs, first_order);
 
-	pareto_one = MDR::optimize_designs(designs2, second_order);
+	std::cout << "Number of designs in pareto front (#1): " << pareto_one.back().size() << std::endl;
 
-	std::cout << "Number of designs in pareto front (#2): " << designs2.size() << std::endl;
+	// Write the fronts (including the ids, metric values and ranks of every design)
+	if (!MDR::write_fronts(pareto_one, "pareto1.csv", MDR::FrontFormat::CSV)) {
+		std::cout << "Could not write pareto1.csv" << std::endl;
+	}
 
-	// Create and open a text file
-	std::ofstream MyFile2("pareto2.csv");
+	// Perform the 2nd pareto front
+	std::vector<MDR::DomRel> second_order = { MDR::DomRel(1, 3) };
 
-	if (designs2.size() > 0) {
-		for (size_t i = 0; i < designs2.size() - 1; i++) {
-			std::cout << designs2[i].get_design_id() << ",";
-			MyFile2 << std::to_string(designs2[i].get_design_id()) << ",";
-		}
-		std::cout << designs2[designs2.size() - 1].get_design_id() << std::endl;
-		MyFile2 << std::to_string(designs2[designs2.size() - 1].get_design_id());
-	}
+	auto pareto_two = MDR::optimize_designs(designs, second_order);
 
-	// Close the file
-	MyFile2.close();
+	std::cout << "Number of designs in pareto front (#2): " << pareto_two.back().size() << std::endl;
 
-	std::cout << "Hello World!\n";
+	if (!MDR::write_fronts(pareto_two, "pareto2.csv", MDR::FrontFormat::CSV)) {
+		std::cout << "Could not write pareto2.csv" << std::endl;
+	}
 }
 
 // Run program: Ctrl + F5 or Debug > Start Without Debugging menu
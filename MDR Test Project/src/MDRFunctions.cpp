@@ -4,6 +4,9 @@
 #include <assert.h>
 #include <iostream>
 #include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <unordered_map>
 
 #include "../headers/DesignClasses.h"
 #include "../headers/MDRFunctions.h"
@@ -36,8 +39,10 @@ namespace MDR {
 		// Retrieve the values of the first performance metric
 		double first_perf_val_A = 0;
 		double first_perf_val_B = 0;
-		assert(A.get_perf_val(first_metric_id, first_perf_val_A)); // Check OK ID
-		assert(B.get_perf_val(first_metric_id, first_perf_val_B)); // Check OK ID
+		const bool found_first = A.get_perf_val(first_metric_id, first_perf_val_A) &&
+			B.get_perf_val(first_metric_id, first_perf_val_B);
+		assert(found_first); // Check OK IDs
+		(void)found_first;
 
 		// Find out whether this value is to be minimized or maximized
 		bool first_minimize_A = true;
@@ -49,8 +54,10 @@ namespace MDR {
 		// Retrieve the values of the second performance metric
 		double second_perf_val_A = 0;
 		double second_perf_val_B = 0;
-		assert(A.get_perf_val(second_metric_id, second_perf_val_A)); // Check OK ID
-		assert(B.get_perf_val(second_metric_id, second_perf_val_B)); // Check OK ID
+		const bool found_second = A.get_perf_val(second_metric_id, second_perf_val_A) &&
+			B.get_perf_val(second_metric_id, second_perf_val_B);
+		assert(found_second); // Check OK IDs
+		(void)found_second;
 
 		// Find out whether this value is to be minimized or maximized
 		bool second_minimize_A = true;
@@ -86,30 +93,32 @@ namespace MDR {
 	// Given two Designs A and B, return whether A dominates B given an order perf_ids.
 	// The perf_ids must hold an even number of ids
 	// MO concept from https://en.wikipedia.org/wiki/Multi-objective_optimization
-	bool A_dominates_B_MO(const Design& A, const Design& B, std::vector<size_t> perf_ids) {
+	bool A_dominates_B_MO(const Design& A, const Design& B, const std::vector<size_t>& perf_ids) {
 
-		std::vector<PerfMetric> perf_metrics_A = A.get_perf_vector();
-
-		// Populate the perf_ids vector if empty
+		// Populate the ids vector if perf_ids is empty
+		std::vector<size_t> default_ids;
 		if (perf_ids.size() < 1){
-			for (size_t i = 1; i < perf_metrics_A.size(); i++) {
-				perf_ids.push_back(i);
+			for (size_t i = 1; i < A.get_perf_vector_view().size(); i++) {
+				default_ids.push_back(i);
 			}
 		}
+		const std::vector<size_t>& ids = perf_ids.size() < 1 ? default_ids : perf_ids;
 
 		// Store the result whether A dominates B in all required elements. Assume true
 		bool dominance = true;
 
 		// Loop across all performance metrics
-		for (size_t i = 1; i < perf_ids.size(); i += 2) {
-			const size_t first_metric_id = perf_ids[i-1];
-			const size_t second_metric_id = perf_ids[i];
+		for (size_t i = 1; i < ids.size(); i += 2) {
+			const size_t first_metric_id = ids[i-1];
+			const size_t second_metric_id = ids[i];
 
 			// Retrieve the values of the first performance metric
 			double first_perf_val_A = 0;
 			double first_perf_val_B = 0;
-			assert(A.get_perf_val(first_metric_id, first_perf_val_A)); // Check OK ID
-			assert(B.get_perf_val(first_metric_id, first_perf_val_B)); // Check OK ID
+			const bool found_first = A.get_perf_val(first_metric_id, first_perf_val_A) &&
+				B.get_perf_val(first_metric_id, first_perf_val_B);
+			assert(found_first); // Check OK IDs
+			(void)found_first;
 
 			// Find out whether this value is to be minimized or maximized
 			bool first_minimize_A = true;
@@ -121,8 +130,10 @@ namespace MDR {
 			// Retrieve the values of the second performance metric
 			double second_perf_val_A = 0;
 			double second_perf_val_B = 0;
-			assert(A.get_perf_val(second_metric_id, second_perf_val_A)); // Check OK ID
-			assert(B.get_perf_val(second_metric_id, second_perf_val_B)); // Check OK ID
+			const bool found_second = A.get_perf_val(second_metric_id, second_perf_val_A) &&
+				B.get_perf_val(second_metric_id, second_perf_val_B);
+			assert(found_second); // Check OK IDs
+			(void)found_second;
 
 			// Find out whether this value is to be minimized or maximized
 			bool second_minimize_A = true;
@@ -152,7 +163,7 @@ namespace MDR {
 			}
 
 			// MDR considers relations in pairs (this is the smart bit)
-			dominance == dominance && first_dominance && second_dominance;
+			dominance = dominance && first_dominance && second_dominance;
 
 			// Don't bother looping any more if the variable does not dominate
 			if (dominance == false) {
@@ -172,7 +183,7 @@ namespace MDR {
 
 		// Check the dominance relation layer by layer (MDR)
 		for (size_t i = 0; i < dominance_relations.size(); i++) {
-			DomRel current_dom_rel = dominance_relations[i];
+			const DomRel& current_dom_rel = dominance_relations[i];
 
 			if (A_dominates_B_2D(A, B, current_dom_rel[0], current_dom_rel[1])) {
 				// If A dominates B at the current dominance level, A dominates B according to MDR.
@@ -195,14 +206,14 @@ namespace MDR {
 	//
 	// Implementation of Algorithm 2 from L. W. Cook et. al.
 	void update_ranks(Design& new_design, std::vector<Design>& existing_designs,
-		std::vector<DomRel> id_order) {
+		const std::vector<DomRel>& id_order) {
 		// For each existing design
 		for (size_t i = 0; i < existing_designs.size(); i++) {
-			Design current_design = existing_designs[i];
+			Design& current_design = existing_designs[i];
 
 			// For each dominance layer
 			for (size_t j = 0; j < id_order.size(); j++) {
-				DomRel current_rel = id_order[j];
+				const DomRel& current_rel = id_order[j];
 
 				if (A_dominates_B_2D(current_design, new_design,
 					current_rel[0], current_rel[1])) {
@@ -220,10 +231,154 @@ namespace MDR {
 		}
 	}
 
+	// Given a list of designs and the metrics used by some dominance relations, group the
+	// designs which hold identical values in all of those metrics (of my own design).
+	//
+	// The first design of each group is its representative. On output, representatives
+	// holds the index of every representative, multiplicities the size of its group and
+	// owners, for every design, the position of its group in representatives.
+	void collapse_duplicate_designs(const std::vector<Design>& design_list,
+		const std::vector<size_t>& metric_ids, std::vector<size_t>& representatives,
+		std::vector<size_t>& multiplicities, std::vector<size_t>& owners) {
+
+		const size_t num_metrics = metric_ids.size();
+
+		representatives.clear();
+		multiplicities.clear();
+		owners.assign(design_list.size(), 0);
+
+		// Store the bit pattern of every active value. Identical bit patterns give identical
+		// comparisons, so designs sharing them can never be told apart by dominance.
+		std::vector<uint64_t> keys(design_list.size() * num_metrics);
+		for (size_t i = 0; i < design_list.size(); i++) {
+			for (size_t k = 0; k < num_metrics; k++) {
+				double val = 0;
+				const bool found = design_list[i].get_perf_val(metric_ids[k], val);
+				assert(found); // Check OK ID
+				(void)found;
+
+				// -0 and +0 compare equal, so they must share a key
+				if (val == 0) {
+					val = 0;
+				}
+
+				uint64_t key = 0;
+				std::memcpy(&key, &val, sizeof(key));
+				keys[i * num_metrics + k] = key;
+			}
+		}
+
+		// Hash and compare designs by their row of keys
+		auto row_hash = [&keys, num_metrics](const size_t& i) {
+			uint64_t hash = 14695981039346656037ULL;
+			for (size_t k = 0; k < num_metrics; k++) {
+				hash ^= keys[i * num_metrics + k];
+				hash *= 1099511628211ULL;
+				hash ^= hash >> 29;
+			}
+			return static_cast<size_t>(hash);
+		};
+		auto row_equal = [&keys, num_metrics](const size_t& i, const size_t& j) {
+			return std::equal(keys.begin() + i * num_metrics, keys.begin() + (i + 1) * num_metrics,
+				keys.begin() + j * num_metrics);
+		};
+
+		// Map the index of each representative to its position in representatives
+		std::unordered_map<size_t, size_t, decltype(row_hash), decltype(row_equal)>
+			groups(design_list.size(), row_hash, row_equal);
+
+		for (size_t i = 0; i < design_list.size(); i++) {
+			const auto result = groups.emplace(i, representatives.size());
+
+			if (result.second) {
+				// First time these values have been seen
+				representatives.push_back(i);
+				multiplicities.push_back(1);
+			}
+			else {
+				multiplicities[result.first->second] += 1;
+			}
+			owners[i] = result.first->second;
+		}
+	}
+
+	// Count the number of times each design of a list is dominated according to MDR given
+	// a list of dominance relations. The result is stored in dominations (an argument of
+	// this function).
+	//
+	// If collapse_duplicates is true, designs with identical values in the metrics of
+	// dom_rels are first collapsed into a single representative, the dominance checks are
+	// only performed between representatives (weighted by the size of their groups) and
+	// the tallies are then expanded back. Identical designs never dominate each other, so
+	// the result is the same as for the full list.
+	void count_dominations(const std::vector<Design>& design_list,
+		const std::vector<DomRel>& dom_rels, std::vector<size_t>& dominations,
+		const bool& collapse_duplicates) {
+
+		dominations.assign(design_list.size(), 0);
+
+		if (!collapse_duplicates) {
+			for (size_t i = 0; i + 1 < design_list.size(); i++)
+			{
+				for (size_t j = i + 1; j < design_list.size(); j++) {
+
+					// Tally the number of times a design is dominated
+					if (A_dominates_B_MDR(design_list[i], design_list[j], dom_rels)) {
+						dominations[j] += 1;
+					}
+					else if (A_dominates_B_MDR(design_list[j], design_list[i], dom_rels)) {
+						dominations[i] += 1;
+					}
+				}
+			}
+			return;
+		}
+
+		// Find the metrics involved in the dominance relations
+		std::vector<size_t> metric_ids;
+		for (const DomRel& dom_rel : dom_rels) {
+			for (int k = 0; k < 2; k++) {
+				if (std::find(metric_ids.begin(), metric_ids.end(), dom_rel[k]) == metric_ids.end()) {
+					metric_ids.push_back(dom_rel[k]);
+				}
+			}
+		}
+
+		std::vector<size_t> representatives;
+		std::vector<size_t> multiplicities;
+		std::vector<size_t> owners;
+		collapse_duplicate_designs(design_list, metric_ids, representatives, multiplicities,
+			owners);
+
+		// Tally the dominations of the representatives, weighted by the group sizes
+		std::vector<size_t> rep_dominations(representatives.size(), 0);
+		for (size_t i = 0; i + 1 < representatives.size(); i++)
+		{
+			const Design& design_i = design_list[representatives[i]];
+
+			for (size_t j = i + 1; j < representatives.size(); j++) {
+				const Design& design_j = design_list[representatives[j]];
+
+				if (A_dominates_B_MDR(design_i, design_j, dom_rels)) {
+					rep_dominations[j] += multiplicities[i];
+				}
+				else if (A_dominates_B_MDR(design_j, design_i, dom_rels)) {
+					rep_dominations[i] += multiplicities[j];
+				}
+			}
+		}
+
+		// Expand the tallies back to the full list
+		for (size_t i = 0; i < design_list.size(); i++) {
+			dominations[i] = rep_dominations[owners[i]];
+		}
+	}
+
 	// Returns the 2D pareto front within a list of designs and a set of dominance relations
 	// 
 	// A part of the combined implementations of Algorithms 2 and 4 from L. W. Cook et. al.
-	std::vector<Design> find_pareto_front(std::vector<Design>& design_list, const DomRel& dom_rel) {
+	std::vector<Design> find_pareto_front(const std::vector<Design>& design_list,
+		const DomRel& dom_rel, const bool& collapse_duplicates) {
 
 		// Initialise the vector containing the dominance relations
 		std::vector<DomRel> dom_rels = { dom_rel };
@@ -231,30 +386,20 @@ namespace MDR {
 		// Initialise the vector containing the pareto front
 		std::vector<Design> pareto_front;
 
-		// Initialise the vector to store the ranks of the design
-		std::vector<double> dominations(design_list.size());
-		std::fill(dominations.begin(), dominations.end(), 0);
-
-		for (size_t i = 0; i < design_list.size() - 1; i++)
-		{
-			for (size_t j = i + 1; j < design_list.size(); j++) {
-
-				// Tally the number of times a design is dominated
-				if (A_dominates_B_MDR(design_list[i], design_list[j], dom_rels)) {
-					dominations[j] += 1;
-				}
-				else if (A_dominates_B_MDR(design_list[j], design_list[i], dom_rels)) {
-					dominations[i] += 1;
-				}
-			}
+		if (design_list.size() < 1) {
+			return pareto_front;
 		}
 
+		// Tally the number of times each design is dominated
+		std::vector<size_t> dominations;
+		count_dominations(design_list, dom_rels, dominations, collapse_duplicates);
+
 		// Extract the minimum times a design is dominated
-		const double mindom = *std::min_element(dominations.begin(), dominations.end());
+		const size_t mindom = *std::min_element(dominations.begin(), dominations.end());
 
 		// If a design is dominated the minimum number of times, it's in the pareto front
 		for (size_t i = 0; i < dominations.size(); i++) {
-			if (std::abs(dominations[i] - mindom) < 1e-6) {
+			if (dominations[i] == mindom) {
 				pareto_front.push_back(design_list[i]);
 			}
 		}
@@ -266,15 +411,15 @@ namespace MDR {
 	// Find the set of pareto fronts given a list of designs and some dominance relations
 	// A part of the combined implementations of Algorithms 2 and 4 from L. W. Cook et. al.
 	std::vector<std::vector<Design>> optimize_designs(const std::vector<Design>& design_list,
-		const std::vector<DomRel>& dom_rels) {
+		const std::vector<DomRel>& dom_rels, const bool& collapse_duplicates) {
 
 		std::vector<std::vector<Design>> pareto_fronts;
 		pareto_fronts.push_back(design_list);
 
 		// Check all designs have the same number of performance metrics
 		for (size_t i = 1; i < design_list.size(); i++) {
-			assert(design_list[i - 1].get_perf_vector().size() ==
-				design_list[i].get_perf_vector().size());
+			assert(design_list[i - 1].get_perf_vector_view().size() ==
+				design_list[i].get_perf_vector_view().size());
 		}
 
 		std::vector<Design> result_designs = design_list; // Placeholder to store the resultant list
@@ -283,7 +428,7 @@ namespace MDR {
 		for (size_t i = 0; i < dom_rels.size(); i += 2) { // Minus one to deal with the edge case
 
 			// Find the current pareto front
-			result_designs = find_pareto_front(result_designs, dom_rels[i]);
+			result_designs = find_pareto_front(result_designs, dom_rels[i], collapse_duplicates);
 			pareto_fronts.push_back(result_designs);
 		}
 
@@ -0,0 +1,221 @@
+#include <vector>
+#include <thread>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <cmath>
+#include <assert.h>
+
+#include "../headers/DesignClasses.h"
+#include "../headers/RadixFront.h"
+
+namespace MDR {
+
+	// The code in this file is of my own design.
+
+	// Number of bits sorted by each pass of the radix sort
+	const size_t RADIX_BITS = 8;
+	const size_t RADIX_BUCKETS = size_t(1) << RADIX_BITS;
+
+	// Below this size the radix sort runs on a single thread
+	const size_t RADIX_PARALLEL_MIN = size_t(1) << 16;
+
+	// Encode a performance metric value as an order-preserving key
+	uint64_t encode_metric_key(const double& val, const bool& minimize) {
+		if (std::isnan(val)) {
+			return NAN_METRIC_KEY;
+		}
+
+		double corrected = minimize ? val : -val;
+
+		// -0 and +0 compare equal, so they must share a key
+		if (corrected == 0) {
+			corrected = 0;
+		}
+
+		uint64_t bits = 0;
+		std::memcpy(&bits, &corrected, sizeof(bits));
+
+		// Negative values are ordered backwards, so flip all their bits. Positive values
+		// only need to be moved above the negative ones.
+		const uint64_t sign = uint64_t(1) << 63;
+		return (bits & sign) ? ~bits : (bits | sign);
+	}
+
+	// Sort a list of keys with a parallel LSD radix sort, applying the same permutation to ids
+	void radix_sort_keys(std::vector<uint64_t>& keys, std::vector<size_t>& ids,
+		size_t num_threads) {
+
+		assert(keys.size() == ids.size());
+		const size_t n = keys.size();
+
+		if (num_threads == 0) {
+			num_threads = std::max<size_t>(1, std::thread::hardware_concurrency());
+		}
+		if (n < RADIX_PARALLEL_MIN) {
+			num_threads = 1;
+		}
+
+		// Bits which differ between the keys. Passes over identical digits are skipped.
+		uint64_t all_and = UINT64_MAX;
+		uint64_t all_or = 0;
+		for (const uint64_t& key : keys) {
+			all_and &= key;
+			all_or |= key;
+		}
+		const uint64_t varying_bits = all_and ^ all_or;
+
+		std::vector<uint64_t> keys_buffer(n);
+		std::vector<size_t> ids_buffer(n);
+
+		// Each thread handles a contiguous chunk of the input
+		const size_t chunk = (n + num_threads - 1) / num_threads;
+		std::vector<size_t> histograms(num_threads * RADIX_BUCKETS);
+
+		for (size_t shift = 0; shift < 64; shift += RADIX_BITS) {
+			if (((varying_bits >> shift) & (RADIX_BUCKETS - 1)) == 0) {
+				continue;
+			}
+
+			std::fill(histograms.begin(), histograms.end(), 0);
+
+			// Run a function on every chunk, in parallel if there is more than one thread
+			auto for_each_chunk = [&](auto&& func) {
+				if (num_threads == 1) {
+					func(0, 0, n);
+					return;
+				}
+
+				std::vector<std::thread> workers;
+				for (size_t t = 0; t < num_threads; t++) {
+					const size_t begin = std::min(n, t * chunk);
+					const size_t end = std::min(n, begin + chunk);
+					workers.emplace_back(func, t, begin, end);
+				}
+				for (std::thread& worker : workers) {
+					worker.join();
+				}
+			};
+
+			// Count the digits of every chunk
+			for_each_chunk([&](size_t t, size_t begin, size_t end) {
+				size_t* histogram = &histograms[t * RADIX_BUCKETS];
+				for (size_t i = begin; i < end; i++) {
+					histogram[(keys[i] >> shift) & (RADIX_BUCKETS - 1)]++;
+				}
+			});
+
+			// Turn the counts into output offsets: digit by digit, then chunk by chunk, which
+			// keeps the sort stable
+			size_t offset = 0;
+			for (size_t d = 0; d < RADIX_BUCKETS; d++) {
+				for (size_t t = 0; t < num_threads; t++) {
+					const size_t count = histograms[t * RADIX_BUCKETS + d];
+					histograms[t * RADIX_BUCKETS + d] = offset;
+					offset += count;
+				}
+			}
+
+			// Scatter every chunk to its place
+			for_each_chunk([&](size_t t, size_t begin, size_t end) {
+				size_t* offsets = &histograms[t * RADIX_BUCKETS];
+				for (size_t i = begin; i < end; i++) {
+					const size_t dest = offsets[(keys[i] >> shift) & (RADIX_BUCKETS - 1)]++;
+					keys_buffer[dest] = keys[i];
+					ids_buffer[dest] = ids[i];
+				}
+			});
+
+			keys.swap(keys_buffer);
+			ids.swap(ids_buffer);
+		}
+	}
+
+	// Return the indices of the designs in the 2D pareto front of a dominance relation
+	std::vector<size_t> find_pareto_front_radix_ids(const std::vector<Design>& design_list,
+		const DomRel& dom_rel, const size_t& num_threads) {
+
+		const size_t n = design_list.size();
+
+		// A design holding a NaN is never dominated (and never dominates), so it is in
+		// the front and left out of the sweep
+		std::vector<bool> in_front(n, false);
+
+		std::vector<uint64_t> first_keys;
+		std::vector<uint64_t> second_keys(n, NAN_METRIC_KEY);
+		std::vector<size_t> ids;
+		first_keys.reserve(n);
+		ids.reserve(n);
+
+		for (size_t i = 0; i < n; i++) {
+			double first_val = 0;
+			double second_val = 0;
+			bool first_minimize = true;
+			bool second_minimize = true;
+
+			const bool found = design_list[i].get_perf_val(dom_rel[0], first_val) &&
+				design_list[i].get_perf_val(dom_rel[1], second_val);
+			assert(found); // Check OK ID
+			(void)found;
+
+			design_list[i].get_perf_minimize(dom_rel[0], first_minimize);
+			design_list[i].get_perf_minimize(dom_rel[1], second_minimize);
+
+			if (std::isnan(first_val) || std::isnan(second_val)) {
+				in_front[i] = true;
+				continue;
+			}
+
+			first_keys.push_back(encode_metric_key(first_val, first_minimize));
+			second_keys[i] = encode_metric_key(second_val, second_minimize);
+			ids.push_back(i);
+		}
+
+		radix_sort_keys(first_keys, ids, num_threads);
+
+		// Sweep over groups of designs sharing the same first key. A design is dominated if
+		// and only if a design from an earlier group (strictly better first metric) has a
+		// strictly better second metric.
+		bool seen_earlier = false;
+		uint64_t best_earlier = 0;
+
+		size_t group_begin = 0;
+		while (group_begin < ids.size()) {
+			size_t group_end = group_begin;
+			uint64_t best_in_group = UINT64_MAX;
+
+			while (group_end < ids.size() && first_keys[group_end] == first_keys[group_begin]) {
+				const uint64_t second_key = second_keys[ids[group_end]];
+
+				if (!seen_earlier || !(best_earlier < second_key)) {
+					in_front[ids[group_end]] = true;
+				}
+				best_in_group = std::min(best_in_group, second_key);
+				group_end++;
+			}
+
+			best_earlier = seen_earlier ? std::min(best_earlier, best_in_group) : best_in_group;
+			seen_earlier = true;
+			group_begin = group_end;
+		}
+
+		std::vector<size_t> front_ids;
+		for (size_t i = 0; i < n; i++) {
+			if (in_front[i]) {
+				front_ids.push_back(i);
+			}
+		}
+		return front_ids;
+	}
+
+	// Returns the 2D pareto front within a list of designs and a dominance relation
+	std::vector<Design> find_pareto_front_radix(const std::vector<Design>& design_list,
+		const DomRel& dom_rel, const size_t& num_threads) {
+
+		std::vector<Design> pareto_front;
+		for (const size_t& i : find_pareto_front_radix_ids(design_list, dom_rel, num_threads)) {
+			pareto_front.push_back(design_list[i]);
+		}
+		return pareto_front;
+	}
+}
@@ -0,0 +1,665 @@
+#include <vector>
+#include <string>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <queue>
+#include <map>
+#include <unordered_set>
+#include <utility>
+#include <cstdint>
+#include <condition_variable>
+#include <charconv>
+#include <cctype>
+#include <iostream>
+#include <algorithm>
+
+#ifndef _WIN32
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/time.h>
+#include <poll.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include "../headers/DesignClasses.h"
+#include "../headers/MDRFunctions.h"
+#include "../headers/RankingServer.h"
+
+namespace MDR {
+
+	// The code in this file is of my own design.
+
+	// Once a snapshot holds more blocks than this, an insert merges them into one
+	const size_t SERVER_MAX_BLOCKS = 64;
+
+	// Size of the buffer used to read from a connection
+	const size_t SERVER_READ_SIZE = 65536;
+
+	// Longest wait (in milliseconds) before run checks whether the server has been stopped
+	const int SERVER_POLL_TIMEOUT_MS = 200;
+
+	// Longest wait (in seconds) for a client to accept a response before it is disconnected
+	const int SERVER_SEND_TIMEOUT_S = 10;
+
+#ifdef MSG_NOSIGNAL
+	// A client disconnecting early must not kill the server with SIGPIPE
+	const int SERVER_SEND_FLAGS = MSG_NOSIGNAL;
+#else
+	const int SERVER_SEND_FLAGS = 0;
+#endif
+
+	// Split a string on whitespace
+	void split_tokens(const std::string& str, std::vector<std::string>& tokens) {
+		tokens.clear();
+		size_t pos = 0;
+		while (pos < str.size()) {
+			while (pos < str.size() && std::isspace(static_cast<unsigned char>(str[pos]))) {
+				pos++;
+			}
+			const size_t start = pos;
+			while (pos < str.size() && !std::isspace(static_cast<unsigned char>(str[pos]))) {
+				pos++;
+			}
+			if (pos > start) {
+				tokens.push_back(str.substr(start, pos - start));
+			}
+		}
+	}
+
+	// Parse a whole token as a number. This function will return true if the operation
+	// is successful.
+	template <typename T>
+	bool parse_token(const std::string& token, T& val) {
+		const char* end = token.data() + token.size();
+		const std::from_chars_result result = std::from_chars(token.data(), end, val);
+		return result.ec == std::errc() && result.ptr == end;
+	}
+
+	RankingServer::RankingServer(const std::vector<Design>& design_list,
+		const std::vector<DomRel>& dom_rels, const size_t& num_threads) {
+
+		if (design_list.size() > 0) {
+			m_metric_layout = design_list[0].get_perf_vector();
+		}
+		m_dom_rels = dom_rels;
+		m_num_threads = num_threads > 0 ? num_threads :
+			std::max<size_t>(1, std::thread::hardware_concurrency());
+
+		std::shared_ptr<Snapshot> snapshot = std::make_shared<Snapshot>();
+		add_block(*snapshot, std::make_shared<const std::vector<Design>>(design_list));
+		m_snapshot = snapshot;
+	}
+
+	std::shared_ptr<const RankingServer::Snapshot> RankingServer::get_snapshot() {
+		std::lock_guard<std::mutex> lock(m_snapshot_mutex);
+		return m_snapshot;
+	}
+
+	void RankingServer::add_block(Snapshot& snapshot,
+		const std::shared_ptr<const std::vector<Design>>& block) const {
+
+		const size_t old_size = snapshot.size;
+		snapshot.blocks.push_back(block);
+		snapshot.size += block->size();
+		snapshot.designs.reserve(snapshot.size);
+		for (const Design& design : *block) {
+			snapshot.index_by_id.emplace(design.get_design_id(), snapshot.designs.size());
+			snapshot.designs.push_back(&design);
+		}
+
+		// Only the pairs involving a new design can change the counts
+		std::vector<size_t>& dominations = snapshot.dominations;
+		dominations.resize(snapshot.size, 0);
+		for (size_t b = old_size; b < snapshot.size; b++) {
+			const Design& added = *snapshot.designs[b];
+			for (size_t i = 0; i < snapshot.size; i++) {
+				if (i == b) {
+					continue;
+				}
+				if (A_dominates_B_MDR(added, *snapshot.designs[i], m_dom_rels)) {
+					dominations[i] += 1;
+				}
+				// Pairs of new designs are checked in both orders by the outer loop
+				if (i < old_size && A_dominates_B_MDR(*snapshot.designs[i], added, m_dom_rels)) {
+					dominations[b] += 1;
+				}
+			}
+		}
+	}
+
+	std::string RankingServer::handle_batch(const std::string& requests) {
+		std::string responses;
+		size_t start = 0;
+		size_t end = requests.find('\n');
+
+		while (end != std::string::npos) {
+			std::string line = requests.substr(start, end - start);
+			if (line.size() > 0 && line.back() == '\r') {
+				line.pop_back();
+			}
+			responses += handle_request(line);
+			responses += "\n";
+
+			start = end + 1;
+			end = requests.find('\n', start);
+		}
+
+		return responses;
+	}
+
+	std::string RankingServer::handle_request(const std::string& request) {
+		std::vector<std::string> tokens;
+
+		// INSERT may hold several designs separated by semicolons, so it is split later
+		const size_t command_end = std::min(request.find_first_of(" \t"), request.size());
+		const std::string command = request.substr(0, command_end);
+
+		if (command == "INSERT") {
+			tokens.push_back(request.substr(std::min(command_end + 1, request.size())));
+			return handle_insert(tokens);
+		}
+
+		split_tokens(request, tokens);
+		if (tokens.size() < 1) {
+			return "ERROR empty request";
+		}
+
+		if (tokens[0] == "RANK") {
+			return handle_rank(tokens);
+		}
+		else if (tokens[0] == "FRONT") {
+			return handle_front(tokens);
+		}
+		else if (tokens[0] == "DOMINATED") {
+			return handle_dominated(tokens);
+		}
+		else if (tokens[0] == "SIZE") {
+			return "SIZE " + std::to_string(get_snapshot()->size);
+		}
+
+		return "ERROR unknown request " + tokens[0];
+	}
+
+	std::string RankingServer::handle_insert(const std::vector<std::string>& tokens) {
+		const std::string& designs_str = tokens[0];
+
+		// Parse every design before touching the population
+		std::shared_ptr<std::vector<Design>> block = std::make_shared<std::vector<Design>>();
+		std::vector<std::string> design_tokens;
+		std::vector<PerfMetric> perf_vector = m_metric_layout;
+		std::unordered_set<size_t> block_ids;
+
+		size_t start = 0;
+		while (start <= designs_str.size()) {
+			size_t end = designs_str.find(';', start);
+			if (end == std::string::npos) {
+				end = designs_str.size();
+			}
+
+			split_tokens(designs_str.substr(start, end - start), design_tokens);
+			start = end + 1;
+
+			if (design_tokens.size() < 1) {
+				continue;
+			}
+			if (design_tokens.size() != 1 + m_metric_layout.size()) {
+				return "ERROR INSERT expects a design id and " +
+					std::to_string(m_metric_layout.size()) + " values per design";
+			}
+
+			size_t design_id = 0;
+			if (!parse_token(design_tokens[0], design_id)) {
+				return "ERROR bad design id " + design_tokens[0];
+			}
+			if (!block_ids.insert(design_id).second) {
+				return "ERROR duplicate design id " + design_tokens[0];
+			}
+
+			for (size_t m = 0; m < m_metric_layout.size(); m++) {
+				double val = 0;
+				if (!parse_token(design_tokens[m + 1], val)) {
+					return "ERROR bad value " + design_tokens[m + 1];
+				}
+				perf_vector[m].set_val(val);
+			}
+
+			block->push_back(Design(perf_vector, design_id, 0, 0));
+		}
+
+		if (block->size() < 1) {
+			return "OK 0";
+		}
+
+		// Build the new snapshot. Queries keep using the previous one in the meantime.
+		std::lock_guard<std::mutex> insert_lock(m_insert_mutex);
+		std::shared_ptr<const Snapshot> current = get_snapshot();
+
+		for (const Design& design : *block) {
+			if (current->index_by_id.count(design.get_design_id()) > 0) {
+				return "ERROR duplicate design id " + std::to_string(design.get_design_id());
+			}
+		}
+
+		std::shared_ptr<Snapshot> snapshot = std::make_shared<Snapshot>();
+		snapshot->blocks = current->blocks;
+		snapshot->size = current->size;
+		snapshot->designs = current->designs;
+		snapshot->index_by_id = current->index_by_id;
+		snapshot->dominations = current->dominations;
+		add_block(*snapshot, block);
+
+		if (snapshot->blocks.size() > SERVER_MAX_BLOCKS) {
+			std::shared_ptr<std::vector<Design>> merged = std::make_shared<std::vector<Design>>();
+			merged->reserve(snapshot->size);
+			for (const auto& old_block : snapshot->blocks) {
+				merged->insert(merged->end(), old_block->begin(), old_block->end());
+			}
+			snapshot->blocks = { merged };
+
+			// The designs keep their indices, only their addresses change
+			for (size_t i = 0; i < merged->size(); i++) {
+				snapshot->designs[i] = &(*merged)[i];
+			}
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(m_snapshot_mutex);
+			m_snapshot = snapshot;
+		}
+
+		return "OK " + std::to_string(block->size());
+	}
+
+	std::string RankingServer::handle_rank(const std::vector<std::string>& tokens) {
+		if (tokens.size() < 2 || tokens.size() % 2 != 0) {
+			return "ERROR RANK expects a design id followed by pairs of metric ids";
+		}
+
+		size_t design_id = 0;
+		if (!parse_token(tokens[1], design_id)) {
+			return "ERROR bad design id " + tokens[1];
+		}
+
+		std::vector<DomRel> dom_rels;
+		for (size_t i = 2; i < tokens.size(); i += 2) {
+			size_t first_id = 0;
+			size_t second_id = 0;
+			if (!parse_token(tokens[i], first_id) || !parse_token(tokens[i + 1], second_id)) {
+				return "ERROR bad metric id";
+			}
+			dom_rels.push_back(DomRel(first_id, second_id));
+		}
+		if (dom_rels.size() < 1) {
+			dom_rels = m_dom_rels;
+		}
+
+		// Check the metric ids, as the dominance functions expect valid ones
+		for (const DomRel& dom_rel : dom_rels) {
+			for (int k = 0; k < 2; k++) {
+				const bool known = std::any_of(m_metric_layout.begin(), m_metric_layout.end(),
+					[&](const PerfMetric& metric) { return metric.get_metric_id() == dom_rel[k]; });
+				if (!known) {
+					return "ERROR unknown metric id " + std::to_string(dom_rel[k]);
+				}
+			}
+		}
+
+		std::shared_ptr<const Snapshot> snapshot = get_snapshot();
+
+		const auto found = snapshot->index_by_id.find(design_id);
+		if (found == snapshot->index_by_id.end()) {
+			return "ERROR unknown design " + tokens[1];
+		}
+		const Design& design = *snapshot->designs[found->second];
+
+		// Count the designs dominating it in each layer
+		std::vector<size_t> ranks(dom_rels.size(), 0);
+		for (const Design* other : snapshot->designs) {
+			for (size_t j = 0; j < dom_rels.size(); j++) {
+				if (A_dominates_B_2D(*other, design, dom_rels[j][0], dom_rels[j][1])) {
+					ranks[j] += 1;
+				}
+			}
+		}
+
+		std::string response = "RANK";
+		for (const size_t& rank : ranks) {
+			response += " " + std::to_string(rank);
+		}
+		return response;
+	}
+
+	std::string RankingServer::handle_front(const std::vector<std::string>& tokens) {
+		size_t k = 0;
+		if (tokens.size() != 2 || !parse_token(tokens[1], k) || k < 1) {
+			return "ERROR FRONT expects a front number starting from 1";
+		}
+
+		std::shared_ptr<const Snapshot> snapshot = get_snapshot();
+
+		// Continue from the fronts already found for this snapshot, on a private copy
+		std::vector<std::vector<size_t>> fronts;
+		std::vector<size_t> remaining;
+		std::vector<size_t> remaining_dominations;
+		bool started = false;
+		{
+			std::lock_guard<std::mutex> lock(snapshot->fronts_mutex);
+			if (snapshot->fronts_started && (snapshot->fronts.size() >= k ||
+				snapshot->remaining.size() < 1)) {
+				return format_front(*snapshot, k <= snapshot->fronts.size() ?
+					&snapshot->fronts[k - 1] : nullptr);
+			}
+
+			started = snapshot->fronts_started;
+			if (started) {
+				fronts = snapshot->fronts;
+				remaining = snapshot->remaining;
+				remaining_dominations = snapshot->remaining_dominations;
+			}
+		}
+		if (!started) {
+			remaining.resize(snapshot->size);
+			for (size_t i = 0; i < snapshot->size; i++) {
+				remaining[i] = i;
+			}
+			remaining_dominations = snapshot->dominations;
+		}
+
+		// Peel fronts off the remaining designs until the k-th one is known. MDR is not
+		// guaranteed to be acyclic, so each front is made of the designs dominated the minimum
+		// number of times (normally 0), as in find_pareto_front.
+		const std::vector<const Design*>& designs = snapshot->designs;
+		while (fronts.size() < k && remaining.size() > 0) {
+			size_t mindom = SIZE_MAX;
+			for (const size_t& i : remaining) {
+				mindom = std::min(mindom, remaining_dominations[i]);
+			}
+
+			std::vector<size_t> front;
+			std::vector<size_t> next_remaining;
+			for (const size_t& i : remaining) {
+				if (remaining_dominations[i] == mindom) {
+					front.push_back(i);
+				}
+				else {
+					next_remaining.push_back(i);
+				}
+			}
+
+			// Take the dominations by the front out of the counts of the other designs
+			for (const size_t& i : next_remaining) {
+				for (const size_t& j : front) {
+					if (A_dominates_B_MDR(*designs[j], *designs[i], m_dom_rels)) {
+						remaining_dominations[i] -= 1;
+					}
+				}
+			}
+
+			fronts.push_back(std::move(front));
+			remaining.swap(next_remaining);
+		}
+
+		const std::string response = format_front(*snapshot, k <= fronts.size() ?
+			&fronts[k - 1] : nullptr);
+
+		// Publish the progress, unless a concurrent query has gone deeper
+		std::lock_guard<std::mutex> lock(snapshot->fronts_mutex);
+		if (!snapshot->fronts_started || fronts.size() > snapshot->fronts.size()) {
+			snapshot->fronts.swap(fronts);
+			snapshot->remaining.swap(remaining);
+			snapshot->remaining_dominations.swap(remaining_dominations);
+			snapshot->fronts_started = true;
+		}
+		return response;
+	}
+
+	std::string RankingServer::format_front(const Snapshot& snapshot,
+		const std::vector<size_t>* front) const {
+
+		std::string response = "FRONT";
+		if (front != nullptr) {
+			for (const size_t& i : *front) {
+				response += " " + std::to_string(snapshot.designs[i]->get_design_id());
+			}
+		}
+		return response;
+	}
+
+	std::string RankingServer::handle_dominated(const std::vector<std::string>& tokens) {
+		if (tokens.size() != 1 + m_metric_layout.size()) {
+			return "ERROR DOMINATED expects " + std::to_string(m_metric_layout.size()) + " values";
+		}
+
+		std::vector<PerfMetric> perf_vector = m_metric_layout;
+		for (size_t m = 0; m < m_metric_layout.size(); m++) {
+			double val = 0;
+			if (!parse_token(tokens[m + 1], val)) {
+				return "ERROR bad value " + tokens[m + 1];
+			}
+			perf_vector[m].set_val(val);
+		}
+		const Design candidate(perf_vector, 0, 0, 0);
+
+		std::shared_ptr<const Snapshot> snapshot = get_snapshot();
+		for (const auto& block : snapshot->blocks) {
+			for (const Design& design : *block) {
+				if (A_dominates_B_MDR(design, candidate, m_dom_rels)) {
+					return "DOMINATED 1";
+				}
+			}
+		}
+		return "DOMINATED 0";
+	}
+
+#ifdef _WIN32
+
+	bool RankingServer::run(const std::string& socket_path) {
+		std::cout << "The ranking server needs Unix domain sockets, which are not supported "
+			"on this platform (" << socket_path << ")" << std::endl;
+		return false;
+	}
+
+	void RankingServer::stop() {
+		m_running = false;
+	}
+
+	bool RankingServer::send_responses(const int& connection, const std::string& responses) {
+		(void)connection;
+		(void)responses;
+		return false;
+	}
+
+#else
+
+	bool RankingServer::run(const std::string& socket_path) {
+		sockaddr_un address{};
+		address.sun_family = AF_UNIX;
+		if (socket_path.size() >= sizeof(address.sun_path)) {
+			std::cout << "Socket path too long: " << socket_path << std::endl;
+			return false;
+		}
+		std::copy(socket_path.begin(), socket_path.end(), address.sun_path);
+
+		const int listener = socket(AF_UNIX, SOCK_STREAM, 0);
+		if (listener < 0) {
+			return false;
+		}
+
+		unlink(socket_path.c_str());
+		if (bind(listener, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0 ||
+			listen(listener, SOMAXCONN) != 0) {
+			std::cout << "Could not listen on " << socket_path << std::endl;
+			close(listener);
+			return false;
+		}
+
+		// Workers write to this pipe when they have answered a batch, to wake up the poll
+		int wake_pipe[2] = { -1, -1 };
+		if (pipe(wake_pipe) != 0) {
+			close(listener);
+			return false;
+		}
+		fcntl(wake_pipe[0], F_SETFL, fcntl(wake_pipe[0], F_GETFL) | O_NONBLOCK);
+
+		m_running = true;
+
+		// Batches of complete request lines waiting for a worker, and the connections whose
+		// batch has been answered (with whether the responses could be sent)
+		std::mutex queue_mutex;
+		std::condition_variable queue_cv;
+		std::queue<std::pair<int, std::string>> batches;
+		std::vector<std::pair<int, bool>> answered;
+		bool done = false;
+
+		std::vector<std::thread> workers;
+		for (size_t t = 0; t < m_num_threads; t++) {
+			workers.emplace_back([&]() {
+				while (true) {
+					std::pair<int, std::string> batch;
+					{
+						std::unique_lock<std::mutex> lock(queue_mutex);
+						queue_cv.wait(lock, [&]() { return done || batches.size() > 0; });
+						if (batches.size() < 1) {
+							return;
+						}
+						batch = std::move(batches.front());
+						batches.pop();
+					}
+
+					const bool sent = send_responses(batch.first, handle_batch(batch.second));
+					{
+						std::lock_guard<std::mutex> lock(queue_mutex);
+						answered.emplace_back(batch.first, sent);
+					}
+					const char wake = 1;
+					const ssize_t woken = write(wake_pipe[1], &wake, 1);
+					(void)woken; // The pipe only fills up if the poll is already due to wake up
+				}
+			});
+		}
+
+		// A single thread polls every connection and hands each batch of complete lines to the
+		// pool. A connection is not polled while one of its batches is being answered, so the
+		// responses are sent in order and idle clients never hold a worker.
+		std::map<int, ServerConnection> clients;
+		std::vector<pollfd> poll_fds;
+		std::vector<char> buffer(SERVER_READ_SIZE);
+
+		while (m_running) {
+			poll_fds.clear();
+			poll_fds.push_back({ listener, POLLIN, 0 });
+			poll_fds.push_back({ wake_pipe[0], POLLIN, 0 });
+			for (const auto& client : clients) {
+				if (!client.second.busy) {
+					poll_fds.push_back({ client.first, POLLIN, 0 });
+				}
+			}
+
+			// Wake up regularly to check whether the server has been stopped
+			if (poll(poll_fds.data(), poll_fds.size(), SERVER_POLL_TIMEOUT_MS) <= 0) {
+				continue;
+			}
+
+			if (poll_fds[1].revents != 0) {
+				char wake[64];
+				while (read(wake_pipe[0], wake, sizeof(wake)) > 0) {}
+
+				std::vector<std::pair<int, bool>> finished;
+				{
+					std::lock_guard<std::mutex> lock(queue_mutex);
+					finished.swap(answered);
+				}
+				for (const std::pair<int, bool>& connection : finished) {
+					if (connection.second) {
+						clients[connection.first].busy = false;
+					}
+					else {
+						close(connection.first);
+						clients.erase(connection.first);
+					}
+				}
+			}
+
+			for (size_t p = 2; p < poll_fds.size(); p++) {
+				if (poll_fds[p].revents == 0) {
+					continue;
+				}
+
+				const int connection = poll_fds[p].fd;
+				ServerConnection& client = clients[connection];
+				const ssize_t bytes_read = read(connection, buffer.data(), buffer.size());
+				if (bytes_read <= 0) {
+					close(connection);
+					clients.erase(connection);
+					continue;
+				}
+				client.pending.append(buffer.data(), static_cast<size_t>(bytes_read));
+
+				// Answer every complete line received so far in a single write
+				const size_t last_newline = client.pending.rfind('\n');
+				if (last_newline == std::string::npos) {
+					continue;
+				}
+
+				client.busy = true;
+				{
+					std::lock_guard<std::mutex> lock(queue_mutex);
+					batches.emplace(connection, client.pending.substr(0, last_newline + 1));
+				}
+				queue_cv.notify_one();
+				client.pending.erase(0, last_newline + 1);
+			}
+
+			if (poll_fds[0].revents != 0) {
+				const int connection = accept(listener, nullptr, nullptr);
+				if (connection >= 0) {
+					// A client which stops reading its responses must not hold a worker forever
+					timeval send_timeout{ SERVER_SEND_TIMEOUT_S, 0 };
+					setsockopt(connection, SOL_SOCKET, SO_SNDTIMEO, &send_timeout,
+						sizeof(send_timeout));
+					clients[connection] = ServerConnection();
+				}
+			}
+		}
+
+		// Answer the batches already received, then close every connection
+		{
+			std::lock_guard<std::mutex> lock(queue_mutex);
+			done = true;
+		}
+		queue_cv.notify_all();
+		for (std::thread& worker : workers) {
+			worker.join();
+		}
+		for (const auto& client : clients) {
+			close(client.first);
+		}
+
+		close(wake_pipe[0]);
+		close(wake_pipe[1]);
+		close(listener);
+		unlink(socket_path.c_str());
+		return true;
+	}
+
+	void RankingServer::stop() {
+		m_running = false;
+	}
+
+	bool RankingServer::send_responses(const int& connection, const std::string& responses) {
+		size_t written = 0;
+		while (written < responses.size()) {
+			const ssize_t bytes_written = send(connection, responses.data() + written,
+				responses.size() - written, SERVER_SEND_FLAGS);
+			if (bytes_written <= 0) {
+				return false;
+			}
+			written += static_cast<size_t>(bytes_written);
+		}
+		return true;
+	}
+
+#endif
+}
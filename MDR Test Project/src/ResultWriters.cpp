@@ -0,0 +1,350 @@
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <span>
+#include <vector>
+#include <thread>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <algorithm>
+
+#include "../headers/DesignClasses.h"
+#include "../headers/ResultWriters.h"
+
+namespace MDR {
+
+	// The code in this file is of my own design.
+
+	// A single design to be written, together with the front layer it belongs to
+	struct FrontRow {
+		size_t front = 0;
+		const Design* design = nullptr;
+	};
+
+	// Number of rows each thread formats before the batch is flushed to disk
+	const size_t ROWS_PER_THREAD = 16384;
+
+	// Append the shortest round-trip representation of a double to a string
+	void append_double(std::string& out, const double& val) {
+		char buffer[32];
+		const std::to_chars_result result = std::to_chars(buffer, buffer + sizeof(buffer), val);
+		out.append(buffer, result.ptr);
+	}
+
+	// Append an unsigned integer to a string
+	void append_size(std::string& out, const size_t& val) {
+		char buffer[24];
+		const std::to_chars_result result = std::to_chars(buffer, buffer + sizeof(buffer), val);
+		out.append(buffer, result.ptr);
+	}
+
+	// Append a string to another one, escaping it so it can be used as a JSON string
+	void append_json_string(std::string& out, const std::string_view& str) {
+		out.push_back('"');
+		for (const char c : str) {
+			if (c == '"' || c == '\\') {
+				out.push_back('\\');
+				out.push_back(c);
+			}
+			else if (static_cast<unsigned char>(c) < 0x20) {
+				const char* hex = "0123456789abcdef";
+				out.append("\\u00");
+				out.push_back(hex[(c >> 4) & 0xF]);
+				out.push_back(hex[c & 0xF]);
+			}
+			else {
+				out.push_back(c);
+			}
+		}
+		out.push_back('"');
+	}
+
+	// Return the number of rank entries of the design with the most dominance layers
+	size_t find_num_ranks(const std::vector<std::vector<Design>>& fronts) {
+		size_t num_ranks = 0;
+		for (const std::vector<Design>& front : fronts) {
+			for (const Design& design : front) {
+				num_ranks = std::max(num_ranks, design.get_ranks_view().size());
+			}
+		}
+		return num_ranks;
+	}
+
+	// Return the performance metrics of the first design found in the fronts. These are
+	// used to name the metric columns of every output format.
+	std::vector<PerfMetric> find_metric_layout(const std::vector<std::vector<Design>>& fronts) {
+		for (const std::vector<Design>& front : fronts) {
+			if (front.size() > 0) {
+				return front[0].get_perf_vector();
+			}
+		}
+		return {};
+	}
+
+	// Format every design of every front with format_row and write the results to "file" in
+	// order. The rows are formatted in batches, each batch being split across num_threads
+	// threads, so that only one batch of text is kept in memory at any time.
+	template <typename RowFormatter>
+	bool write_rows_parallel(std::ofstream& file, const std::vector<std::vector<Design>>& fronts,
+		size_t num_threads, const RowFormatter& format_row) {
+
+		if (num_threads == 0) {
+			num_threads = std::max<size_t>(1, std::thread::hardware_concurrency());
+		}
+
+		const size_t batch_size = num_threads * ROWS_PER_THREAD;
+
+		std::vector<FrontRow> batch;
+		batch.reserve(batch_size);
+		std::vector<std::string> buffers(num_threads);
+
+		// Format and write the rows currently held in the batch
+		auto flush_batch = [&]() {
+			const size_t rows_per_thread = (batch.size() + num_threads - 1) / num_threads;
+			std::vector<std::thread> workers;
+
+			for (size_t t = 0; t < num_threads; t++) {
+				const size_t begin = std::min(batch.size(), t * rows_per_thread);
+				const size_t end = std::min(batch.size(), begin + rows_per_thread);
+				buffers[t].clear();
+
+				if (begin == end) {
+					continue;
+				}
+
+				workers.emplace_back([&, t, begin, end]() {
+					for (size_t i = begin; i < end; i++) {
+						format_row(buffers[t], batch[i]);
+					}
+				});
+			}
+
+			for (std::thread& worker : workers) {
+				worker.join();
+			}
+
+			for (const std::string& buffer : buffers) {
+				file.write(buffer.data(), buffer.size());
+			}
+
+			batch.clear();
+		};
+
+		// Stream the front layers in order
+		for (size_t i = 0; i < fronts.size(); i++) {
+			for (const Design& design : fronts[i]) {
+				batch.push_back({ i, &design });
+
+				if (batch.size() == batch_size) {
+					flush_batch();
+				}
+			}
+		}
+
+		if (batch.size() > 0) {
+			flush_batch();
+		}
+
+		return file.good();
+	}
+
+	// Write a list of pareto fronts to "filename" in the requested format
+	bool write_fronts(const std::vector<std::vector<Design>>& fronts,
+		const std::string& filename, const FrontFormat& format, const size_t& num_threads) {
+
+		switch (format) {
+		case FrontFormat::CSV:
+			return write_fronts_csv(fronts, filename, num_threads);
+		case FrontFormat::Binary:
+			return write_fronts_binary(fronts, filename);
+		case FrontFormat::JSONLines:
+			return write_fronts_json(fronts, filename, num_threads);
+		}
+
+		return false;
+	}
+
+	// Write a list of pareto fronts as CSV
+	bool write_fronts_csv(const std::vector<std::vector<Design>>& fronts,
+		const std::string& filename, const size_t& num_threads) {
+
+		std::ofstream file(filename, std::ios::binary);
+		if (!file.is_open()) {
+			return false;
+		}
+
+		const std::vector<PerfMetric> metric_layout = find_metric_layout(fronts);
+		const size_t num_ranks = find_num_ranks(fronts);
+
+		// Write the header
+		std::string header = "front,design_id";
+		for (const PerfMetric& metric : metric_layout) {
+			header += "," + metric.get_metric_name();
+		}
+		for (size_t i = 0; i < num_ranks; i++) {
+			header += ",rank_";
+			append_size(header, i);
+		}
+		header += "\n";
+		file.write(header.data(), header.size());
+
+		auto format_row = [&](std::string& out, const FrontRow& row) {
+			append_size(out, row.front);
+			out.push_back(',');
+			append_size(out, row.design->get_design_id());
+
+			for (const PerfMetric& metric : row.design->get_perf_vector_view()) {
+				out.push_back(',');
+				append_double(out, metric.get_metric_val());
+			}
+
+			// Designs with fewer dominance layers leave the remaining rank columns empty
+			const std::span<const size_t> ranks = row.design->get_ranks_view();
+			for (size_t i = 0; i < num_ranks; i++) {
+				out.push_back(',');
+				if (i < ranks.size()) {
+					append_size(out, ranks[i]);
+				}
+			}
+
+			out.push_back('\n');
+		};
+
+		return write_rows_parallel(file, fronts, num_threads, format_row);
+	}
+
+	// Write a list of pareto fronts in the columnar binary format
+	bool write_fronts_binary(const std::vector<std::vector<Design>>& fronts,
+		const std::string& filename) {
+
+		std::ofstream file(filename, std::ios::binary);
+		if (!file.is_open()) {
+			return false;
+		}
+
+		const std::vector<PerfMetric> metric_layout = find_metric_layout(fronts);
+		const size_t num_ranks = find_num_ranks(fronts);
+
+		auto write_u64 = [&file](const uint64_t& val) {
+			file.write(reinterpret_cast<const char*>(&val), sizeof(val));
+		};
+
+		// Write the header
+		const uint64_t version = 1;
+		file.write("MDRF", 4);
+		write_u64(version);
+		write_u64(fronts.size());
+		write_u64(metric_layout.size());
+		write_u64(num_ranks);
+
+		for (const PerfMetric& metric : metric_layout) {
+			const std::string_view name = metric.get_metric_name_view();
+			const char minimize = metric.get_metric_minimize() ? 1 : 0;
+			write_u64(name.size());
+			file.write(name.data(), name.size());
+			file.write(&minimize, 1);
+		}
+
+		// Gather each front column by column, so every column is written in a single call
+		std::vector<uint64_t> id_column;
+		std::vector<double> value_columns;
+		std::vector<uint64_t> rank_columns;
+
+		for (const std::vector<Design>& front : fronts) {
+			const size_t num_designs = front.size();
+
+			id_column.assign(num_designs, 0);
+			value_columns.assign(num_designs * metric_layout.size(), 0);
+			rank_columns.assign(num_designs * num_ranks, 0);
+
+			for (size_t i = 0; i < num_designs; i++) {
+				id_column[i] = front[i].get_design_id();
+
+				const std::span<const PerfMetric> perf_vector = front[i].get_perf_vector_view();
+				const size_t num_metrics = std::min(perf_vector.size(), metric_layout.size());
+				for (size_t m = 0; m < num_metrics; m++) {
+					value_columns[m * num_designs + i] = perf_vector[m].get_metric_val();
+				}
+
+				const std::span<const size_t> ranks = front[i].get_ranks_view();
+				const size_t num_design_ranks = std::min(ranks.size(), num_ranks);
+				for (size_t r = 0; r < num_design_ranks; r++) {
+					rank_columns[r * num_designs + i] = ranks[r];
+				}
+			}
+
+			write_u64(num_designs);
+			file.write(reinterpret_cast<const char*>(id_column.data()),
+				id_column.size() * sizeof(uint64_t));
+			file.write(reinterpret_cast<const char*>(value_columns.data()),
+				value_columns.size() * sizeof(double));
+			file.write(reinterpret_cast<const char*>(rank_columns.data()),
+				rank_columns.size() * sizeof(uint64_t));
+		}
+
+		return file.good();
+	}
+
+	// Write a list of pareto fronts as JSON lines
+	bool write_fronts_json(const std::vector<std::vector<Design>>& fronts,
+		const std::string& filename, const size_t& num_threads) {
+
+		std::ofstream file(filename, std::ios::binary);
+		if (!file.is_open()) {
+			return false;
+		}
+
+		// Escape the metric names only once
+		std::vector<std::string> metric_keys;
+		for (const PerfMetric& metric : find_metric_layout(fronts)) {
+			std::string key;
+			append_json_string(key, metric.get_metric_name_view());
+			metric_keys.push_back(key + ":");
+		}
+
+		auto format_row = [&](std::string& out, const FrontRow& row) {
+			out.append("{\"front\":");
+			append_size(out, row.front);
+			out.append(",\"design_id\":");
+			append_size(out, row.design->get_design_id());
+
+			out.append(",\"metrics\":{");
+			const std::span<const PerfMetric> perf_vector = row.design->get_perf_vector_view();
+			for (size_t m = 0; m < perf_vector.size(); m++) {
+				if (m > 0) {
+					out.push_back(',');
+				}
+
+				if (m < metric_keys.size()) {
+					out.append(metric_keys[m]);
+				}
+				else {
+					append_json_string(out, perf_vector[m].get_metric_name_view());
+					out.push_back(':');
+				}
+
+				// JSON has no representation for NaN or infinity
+				const double val = perf_vector[m].get_metric_val();
+				if (std::isfinite(val)) {
+					append_double(out, val);
+				}
+				else {
+					out.append("null");
+				}
+			}
+
+			out.append("},\"ranks\":[");
+			const std::span<const size_t> ranks = row.design->get_ranks_view();
+			for (size_t r = 0; r < ranks.size(); r++) {
+				if (r > 0) {
+					out.push_back(',');
+				}
+				append_size(out, ranks[r]);
+			}
+			out.append("]}\n");
+		};
+
+		return write_rows_parallel(file, fronts, num_threads, format_row);
+	}
+}
@@ -0,0 +1,336 @@
+#include <vector>
+#include <map>
+#include <tuple>
+#include <utility>
+#include <algorithm>
+#include <cstdint>
+#include <assert.h>
+
+#include "../headers/DesignClasses.h"
+#include "../headers/RadixFront.h"
+#include "../headers/SlidingWindowArchive.h"
+
+namespace MDR {
+
+	// The code in this file is of my own design.
+
+	// Priority of a treap node: a mix of the insertion number (SplitMix64), so the tree is
+	// balanced in expectation whatever the order of the keys
+	uint64_t get_node_priority(const size_t& number) {
+		uint64_t z = uint64_t(number) + 0x9e3779b97f4a7c15ULL;
+		z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+		z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+		return z ^ (z >> 31);
+	}
+
+	void SlidingWindowArchive::CandidateTree::update_max(const size_t& node) {
+		Node& n = m_nodes[node];
+
+		// A design holding a NaN never dominates and is never dominated, and 0 is never larger
+		// than a second key
+		n.max_second_key = n.first_key == NAN_METRIC_KEY || n.second_key == NAN_METRIC_KEY ?
+			0 : n.second_key;
+		if (n.left != SIZE_MAX) {
+			n.max_second_key = std::max(n.max_second_key, m_nodes[n.left].max_second_key);
+		}
+		if (n.right != SIZE_MAX) {
+			n.max_second_key = std::max(n.max_second_key, m_nodes[n.right].max_second_key);
+		}
+	}
+
+	void SlidingWindowArchive::CandidateTree::split(const size_t& node, const uint64_t& first_key,
+		const uint64_t& second_key, const size_t& number, const bool& inclusive, size_t& before,
+		size_t& after) {
+
+		if (node == SIZE_MAX) {
+			before = SIZE_MAX;
+			after = SIZE_MAX;
+			return;
+		}
+
+		const Node& n = m_nodes[node];
+		const auto node_key = std::tie(n.first_key, n.second_key, n.number);
+		const auto key = std::tie(first_key, second_key, number);
+		// The children are copied, as the outputs of the recursive call overwrite them
+		if (inclusive ? !(key < node_key) : node_key < key) {
+			const size_t right = n.right;
+			split(right, first_key, second_key, number, inclusive, m_nodes[node].right, after);
+			before = node;
+		}
+		else {
+			const size_t left = n.left;
+			split(left, first_key, second_key, number, inclusive, before, m_nodes[node].left);
+			after = node;
+		}
+		update_max(node);
+	}
+
+	size_t SlidingWindowArchive::CandidateTree::merge(const size_t& before, const size_t& after) {
+		if (before == SIZE_MAX) {
+			return after;
+		}
+		if (after == SIZE_MAX) {
+			return before;
+		}
+
+		if (m_nodes[before].priority > m_nodes[after].priority) {
+			const size_t right = m_nodes[before].right;
+			m_nodes[before].right = merge(right, after);
+			update_max(before);
+			return before;
+		}
+		const size_t left = m_nodes[after].left;
+		m_nodes[after].left = merge(before, left);
+		update_max(after);
+		return after;
+	}
+
+	void SlidingWindowArchive::CandidateTree::insert(const uint64_t& first_key,
+		const uint64_t& second_key, const size_t& number) {
+
+		size_t node = m_nodes.size();
+		if (m_free_nodes.size() > 0) {
+			node = m_free_nodes.back();
+			m_free_nodes.pop_back();
+		}
+		else {
+			m_nodes.emplace_back();
+		}
+
+		Node& n = m_nodes[node];
+		n = Node();
+		n.first_key = first_key;
+		n.second_key = second_key;
+		n.number = number;
+		n.priority = get_node_priority(number);
+		update_max(node);
+
+		size_t before = SIZE_MAX;
+		size_t after = SIZE_MAX;
+		split(m_root, first_key, second_key, number, false, before, after);
+		m_root = merge(merge(before, node), after);
+		m_size += 1;
+	}
+
+	void SlidingWindowArchive::CandidateTree::erase(const uint64_t& first_key,
+		const uint64_t& second_key, const size_t& number) {
+
+		size_t before = SIZE_MAX;
+		size_t rest = SIZE_MAX;
+		size_t found = SIZE_MAX;
+		size_t after = SIZE_MAX;
+		split(m_root, first_key, second_key, number, false, before, rest);
+		split(rest, first_key, second_key, number, true, found, after);
+		m_root = merge(before, after);
+
+		assert(found != SIZE_MAX); // Check OK candidate
+		if (found != SIZE_MAX) {
+			m_free_nodes.push_back(found);
+			m_size -= 1;
+		}
+	}
+
+	void SlidingWindowArchive::CandidateTree::find_dominated(const size_t& node,
+		const uint64_t& first_key, const uint64_t& second_key, std::vector<size_t>& numbers) const {
+
+		// Skip the subtrees without a larger second key
+		if (node == SIZE_MAX || m_nodes[node].max_second_key <= second_key) {
+			return;
+		}
+
+		const Node& n = m_nodes[node];
+		if (n.first_key > first_key) {
+			find_dominated(n.left, first_key, second_key, numbers);
+			if (n.first_key != NAN_METRIC_KEY && n.second_key != NAN_METRIC_KEY &&
+				n.second_key > second_key) {
+				numbers.push_back(n.number);
+			}
+		}
+		find_dominated(n.right, first_key, second_key, numbers);
+	}
+
+	void SlidingWindowArchive::CandidateTree::find_dominated(const uint64_t& first_key,
+		const uint64_t& second_key, std::vector<size_t>& numbers) const {
+		find_dominated(m_root, first_key, second_key, numbers);
+	}
+
+	void SlidingWindowArchive::CandidateTree::collect(const size_t& node,
+		std::vector<std::tuple<uint64_t, uint64_t, size_t>>& candidates) const {
+
+		if (node == SIZE_MAX) {
+			return;
+		}
+		const Node& n = m_nodes[node];
+		collect(n.left, candidates);
+		candidates.emplace_back(n.first_key, n.second_key, n.number);
+		collect(n.right, candidates);
+	}
+
+	void SlidingWindowArchive::CandidateTree::collect(
+		std::vector<std::tuple<uint64_t, uint64_t, size_t>>& candidates) const {
+		candidates.clear();
+		candidates.reserve(m_size);
+		collect(m_root, candidates);
+	}
+
+	// Intended constructor
+	SlidingWindowArchive::SlidingWindowArchive(const std::vector<DomRel>& dom_rels,
+		const size_t& max_designs, const double& max_age) {
+		m_dom_rels = dom_rels;
+		m_max_designs = max_designs;
+		m_max_age = max_age;
+		m_candidates.resize(dom_rels.size());
+		m_fronts.resize(dom_rels.size());
+		m_fronts_valid.assign(dom_rels.size(), true);
+	}
+
+	void SlidingWindowArchive::remove_candidate(ArchiveEntry& entry, const size_t& number,
+		const size_t& layer) {
+		m_candidates[layer].erase(entry.keys[layer][0], entry.keys[layer][1], number);
+		entry.candidate[layer] = false;
+		entry.num_candidate_layers -= 1;
+		m_fronts_valid[layer] = false;
+	}
+
+	void SlidingWindowArchive::expire_oldest() {
+		const auto oldest = m_entries.begin();
+		for (size_t j = 0; j < m_dom_rels.size(); j++) {
+			if (oldest->second.candidate[j]) {
+				remove_candidate(oldest->second, oldest->first, j);
+			}
+		}
+		m_entries.erase(oldest);
+	}
+
+	size_t SlidingWindowArchive::insert(const Design& design, const double& timestamp) {
+		assert(timestamp >= m_last_timestamp); // Check the stream is in order
+		m_last_timestamp = timestamp;
+
+		const size_t number = m_num_inserted;
+		m_num_inserted += 1;
+
+		// Make room for the new design, then drop the designs which are too old
+		while (m_max_designs > 0 && !m_entries.empty() &&
+			m_entries.begin()->first + m_max_designs <= number) {
+			expire_oldest();
+		}
+		expire(timestamp);
+
+		ArchiveEntry entry;
+		entry.design = design;
+		entry.timestamp = timestamp;
+		entry.keys.resize(m_dom_rels.size());
+		entry.candidate.assign(m_dom_rels.size(), true);
+		entry.num_candidate_layers = m_dom_rels.size();
+
+		std::vector<size_t> dominated;
+		for (size_t j = 0; j < m_dom_rels.size(); j++) {
+			for (int k = 0; k < 2; k++) {
+				double val = 0;
+				bool minimize = true;
+				const bool found = design.get_perf_val(m_dom_rels[j][k], val) &&
+					design.get_perf_minimize(m_dom_rels[j][k], minimize);
+				assert(found); // Check OK ID
+				(void)found;
+
+				entry.keys[j][k] = encode_metric_key(val, minimize);
+			}
+			const uint64_t& first_key = entry.keys[j][0];
+			const uint64_t& second_key = entry.keys[j][1];
+
+			// The candidates dominated by the new design can never be part of the front again.
+			// A design holding a NaN never dominates and is never dominated.
+			dominated.clear();
+			if (first_key != NAN_METRIC_KEY && second_key != NAN_METRIC_KEY) {
+				m_candidates[j].find_dominated(first_key, second_key, dominated);
+			}
+
+			for (const size_t& other : dominated) {
+				const auto other_entry = m_entries.find(other);
+				remove_candidate(other_entry->second, other, j);
+				if (other_entry->second.num_candidate_layers == 0) {
+					m_entries.erase(other_entry);
+				}
+			}
+
+			m_candidates[j].insert(first_key, second_key, number);
+			m_fronts_valid[j] = false;
+		}
+
+		if (entry.num_candidate_layers > 0) {
+			m_entries.emplace(number, std::move(entry));
+		}
+
+		return number;
+	}
+
+	void SlidingWindowArchive::expire(const double& now) {
+		if (m_max_age <= 0) {
+			return;
+		}
+
+		// Designs are stored in insertion order, so the oldest ones come first
+		while (!m_entries.empty() && now - m_entries.begin()->second.timestamp > m_max_age) {
+			expire_oldest();
+		}
+	}
+
+	void SlidingWindowArchive::update_front(const size_t& layer) {
+		std::vector<size_t>& front = m_fronts[layer];
+		front.clear();
+
+		// Sweep over groups of candidates sharing the same first key. A candidate is dominated
+		// if and only if a candidate from an earlier group has a smaller second key.
+		bool seen_earlier = false;
+		uint64_t best_earlier = 0;
+
+		std::vector<std::tuple<uint64_t, uint64_t, size_t>> candidates;
+		m_candidates[layer].collect(candidates);
+
+		auto group_begin = candidates.begin();
+		while (group_begin != candidates.end()) {
+			const uint64_t first_key = std::get<0>(*group_begin);
+
+			auto group_end = group_begin;
+			uint64_t best_in_group = NAN_METRIC_KEY;
+			while (group_end != candidates.end() && std::get<0>(*group_end) == first_key) {
+				const uint64_t second_key = std::get<1>(*group_end);
+
+				if (first_key == NAN_METRIC_KEY || second_key == NAN_METRIC_KEY) {
+					front.push_back(std::get<2>(*group_end));
+				}
+				else {
+					if (!seen_earlier || best_earlier >= second_key) {
+						front.push_back(std::get<2>(*group_end));
+					}
+					best_in_group = std::min(best_in_group, second_key);
+				}
+				++group_end;
+			}
+
+			if (best_in_group != NAN_METRIC_KEY) {
+				best_earlier = seen_earlier ? std::min(best_earlier, best_in_group) : best_in_group;
+				seen_earlier = true;
+			}
+			group_begin = group_end;
+		}
+
+		std::sort(front.begin(), front.end());
+		m_fronts_valid[layer] = true;
+	}
+
+	std::vector<Design> SlidingWindowArchive::get_front(const size_t& layer) {
+		assert(layer < m_dom_rels.size()); // Check OK layer
+
+		if (!m_fronts_valid[layer]) {
+			update_front(layer);
+		}
+
+		std::vector<Design> pareto_front;
+		pareto_front.reserve(m_fronts[layer].size());
+		for (const size_t& number : m_fronts[layer]) {
+			pareto_front.push_back(m_entries.at(number).design);
+		}
+		return pareto_front;
+	}
+}